@@ -0,0 +1,70 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "../include/CirculationEngine.h"
+/*
+ * Measures CirculationEngine throughput on a checkout-heavy stream where a large share of the requests is rejected,
+ * against the target of 1M requests per second.
+ * Usage: circulation_benchmark [request count] [book count]
+ */
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    size_t bookCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+
+    UnorderedSet<Book> catalog;
+    std::vector<std::string> isbns;
+    for (size_t i = 0; i < bookCount; ++i) {
+        Book book;
+        book.ISBN = std::to_string(1000000000 + i * 7919);
+        book.copies = 1 + static_cast<int>(i % 3);
+        isbns.push_back(book.ISBN);
+        catalog.insert(book);
+    }
+    CirculationEngine engine(catalog);
+
+    // Popular books take most of the traffic, so they run out of copies and most of their requests are rejected
+    std::mt19937 generator(8042);
+    std::geometric_distribution<size_t> popularity(50.0 / static_cast<double>(bookCount));
+    std::uniform_int_distribution<int> jitter(0, 14);
+    std::uniform_int_distribution<int> length(1, 28);
+    std::bernoulli_distribution malformed(0.01);
+    Date origin(2022, 1, 1);
+    // Requests arrive roughly in checkout order over three years, the way they reach the circulation desk
+    std::vector<BorrowRecord> requests(count);
+    for (size_t i = 0; i < count; ++i) {
+        BorrowRecord& record = requests[i];
+        record.patronId = "user" + std::to_string(generator() % 100000);
+        record.bookISBN = isbns[popularity(generator) % bookCount];
+        record.checkoutDate = origin + static_cast<int>(i * 3 * 365 / count) + jitter(generator);
+        record.returnDate = record.checkoutDate + length(generator);
+        if (malformed(generator)) {
+            std::swap(record.checkoutDate, record.returnDate);
+        }
+    }
+
+    std::vector<CirculationStatus> statuses;
+    auto begin = std::chrono::steady_clock::now();
+    size_t accepted = engine.checkoutBatch(requests, statuses);
+    double checkoutSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    // Only the accepted checkouts come back to the desk
+    std::vector<BorrowRecord> loans;
+    loans.reserve(accepted);
+    for (size_t i = 0; i < count; ++i) {
+        if (statuses[i] == CirculationStatus::OK) {
+            loans.push_back(requests[i]);
+        }
+    }
+    begin = std::chrono::steady_clock::now();
+    size_t returned = engine.returnBatch(loans, statuses);
+    double returnSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    std::cout << "Checkouts:\t" << count << " requests, " << accepted << " accepted, "
+              << count / checkoutSeconds / 1e6 << " M requests/s" << std::endl;
+    std::cout << "Returns:\t" << loans.size() << " requests, " << returned << " accepted, "
+              << loans.size() / returnSeconds / 1e6 << " M requests/s" << std::endl;
+    return 0;
+}
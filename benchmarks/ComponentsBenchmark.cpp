@@ -0,0 +1,96 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "../include/CsrGraph.h"
+#include "../include/GraphTraversal.h"
+#include "../include/ParallelComponents.h"
+/*
+ * Measures how connected components of a large random undirected CSR graph scale with the thread count: the depth
+ * first search LibraryRestructuring runs by default against ParallelComponents on 1, 2, 4, ... threads, checking that
+ * every run labels the vertices identically. Edges are counted in both directions, as they are stored.
+ * Usage: components_benchmark [vertex count] [edge count] [max threads]
+ */
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Random endpoints of every undirected edge, replayed by both passes of the CSR build
+static void randomEdges(uint32_t vertexCount, uint64_t edgeCount, void (*use)(uint32_t, uint32_t, void*),
+                        void* state) {
+    uint64_t seed = 8042;
+    for (uint64_t edge = 0; edge < edgeCount; ++edge) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint32_t from = static_cast<uint32_t>((seed >> 32) % vertexCount);
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint32_t to = static_cast<uint32_t>((seed >> 32) % vertexCount);
+        use(from, to, state);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t vertexCount = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 10000000;
+    uint64_t edgeCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 50000000;
+    unsigned int maxThreads = argc > 3 ? static_cast<unsigned int>(std::strtoul(argv[3], nullptr, 10))
+                                       : std::max(1u, std::thread::hardware_concurrency());
+    if (vertexCount == 0) {
+        std::cerr << "The graph needs at least one vertex" << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint64_t> offsets(uint64_t(vertexCount) + 1, 0);
+    randomEdges(vertexCount, edgeCount / 2, [](uint32_t from, uint32_t to, void* state) {
+        uint64_t* degrees = static_cast<uint64_t*>(state);
+        ++degrees[from + 1];
+        ++degrees[to + 1];
+    }, offsets.data());
+    for (uint32_t vertex = 0; vertex < vertexCount; ++vertex) {
+        offsets[vertex + 1] += offsets[vertex];
+    }
+    struct Fill {
+        std::vector<uint64_t> next;
+        std::vector<uint32_t> targets;
+    } fill{offsets, std::vector<uint32_t>(offsets.back())};
+    randomEdges(vertexCount, edgeCount / 2, [](uint32_t from, uint32_t to, void* state) {
+        Fill* fill = static_cast<Fill*>(state);
+        fill->targets[fill->next[from]++] = to;
+        fill->targets[fill->next[to]++] = from;
+    }, &fill);
+    fill.next = std::vector<uint64_t>();
+    CsrGraph graph(std::move(offsets), std::move(fill.targets));
+    std::cout << "Built a graph of " << graph.vertexCount() << " vertices and " << graph.edgeCount() << " edges in "
+              << secondsSince(start) << " s" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    std::vector<uint32_t> expected(graph.vertexCount());
+    GraphTraversal traversal(graph);
+    std::vector<uint32_t> reached;
+    size_t componentCount = 0;
+    for (uint32_t vertex = 0; vertex < graph.vertexCount(); ++vertex) {
+        reached.clear();
+        traversal.depthFirst(vertex, reached);
+        for (uint32_t member : reached) {
+            expected[member] = vertex;
+        }
+        componentCount += reached.empty() ? 0 : 1;
+    }
+    double sequential = secondsSince(start);
+    std::cout << "Depth first search:\t" << sequential << " s, " << componentCount << " components" << std::endl;
+
+    for (unsigned int threads = 1;; threads = std::min(threads * 2, maxThreads)) {
+        start = std::chrono::steady_clock::now();
+        std::vector<uint32_t> labels = ParallelComponents(graph, threads).labels();
+        double seconds = secondsSince(start);
+        std::cout << "ParallelComponents, " << threads << " threads:\t" << seconds << " s ("
+                  << sequential / seconds << "x the search)" << (labels == expected ? "" : ", LABELS DIFFER")
+                  << std::endl;
+        if (threads >= maxThreads) {
+            break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include "../include/CsvLoader.h"
+/*
+ * Writes a synthetic borrow record dump and measures how fast CsvLoader ingests it into objects and into a
+ * BorrowRecordTable with a growing number of threads.
+ * Usage: csv_loader_benchmark [record count] [max threads] [path]
+ */
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+    unsigned int maxThreads = argc > 2 ? static_cast<unsigned int>(std::atoi(argv[2]))
+                                       : std::max(1u, std::thread::hardware_concurrency());
+    std::string path = argc > 3 ? argv[3] : "/tmp/borrow_records_benchmark.csv";
+
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        std::cerr << "Cannot write " << path << std::endl;
+        return 1;
+    }
+    std::mt19937 generator(8042);
+    std::fputs("patronId,bookISBN,checkoutDate,returnDate\n", file);
+    Date origin(2020, 1, 1);
+    for (size_t i = 0; i < count; ++i) {
+        Date checkout = origin + static_cast<int>(generator() % 1400);
+        Date returned = checkout + static_cast<int>(generator() % 60);
+        auto patron = static_cast<unsigned int>(generator() % 200000);
+        auto isbn = static_cast<unsigned int>(generator() % 500000);
+        // Every twentieth patron id is quoted, as spreadsheet exports do
+        std::fprintf(file, i % 20 == 0 ? "\"user%u\",%010u,%04d-%02d-%02d,%04d-%02d-%02d\n"
+                                       : "user%u,%010u,%04d-%02d-%02d,%04d-%02d-%02d\n",
+                     patron, isbn, checkout.getYear(), checkout.getMonth(),
+                     checkout.getDay(), returned.getYear(), returned.getMonth(), returned.getDay());
+    }
+    long bytes = std::ftell(file);
+    std::fclose(file);
+    double megabytes = static_cast<double>(bytes) / (1 << 20);
+    std::cout << count << " records, " << megabytes << " MB" << std::endl;
+
+    for (unsigned int threads = 1; threads <= maxThreads; threads *= 2) {
+        CsvLoader loader(path, threads);
+        auto start = std::chrono::steady_clock::now();
+        std::vector<BorrowRecord> records = loader.borrowRecords();
+        double objectSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        BorrowRecordTable table = loader.borrowRecordTable();
+        double tableSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << threads << " thread(s):\tobjects " << megabytes / objectSeconds << " MB/s\ttable "
+                  << megabytes / tableSeconds << " MB/s" << (records.size() == count && table.size() == count
+                                                            ? "" : "\tRECORDS MISSING") << std::endl;
+    }
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <thread>
+#include "../include/RadixSort.h"
+/*
+ * Measures how RadixSort::parallelSort scales with the number of threads on borrow-duration style keys.
+ * Usage: radix_sort_benchmark [element count] [max threads]
+ */
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    unsigned int maxThreads = argc > 2 ? static_cast<unsigned int>(std::atoi(argv[2]))
+                                       : std::max(1u, std::thread::hardware_concurrency());
+
+    // Borrow durations in days, skewed towards short loans
+    std::mt19937 generator(8042);
+    std::exponential_distribution<double> duration(1.0 / 21.0);
+    std::vector<int> durations(count);
+    for (int& days : durations) {
+        days = static_cast<int>(duration(generator) * 100);
+    }
+
+    std::cout << "Sorting " << count << " borrow durations" << std::endl;
+    double singleThreaded = 0;
+    for (unsigned int threads = 1; threads <= maxThreads; threads *= 2) {
+        std::vector<int> data = durations;
+        RadixSort<int> radixSort(data, [](const int& days) { return days; });
+        auto start = std::chrono::steady_clock::now();
+        radixSort.parallelSort(threads);
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (threads == 1) {
+            singleThreaded = elapsed;
+        }
+        bool sorted = std::is_sorted(data.begin(), data.end());
+        std::cout << threads << " thread(s):\t" << elapsed << " ms\tspeedup " << singleThreaded / elapsed
+                  << (sorted ? "" : "\tNOT SORTED") << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "../include/ReservationQueue.h"
+/*
+ * Measures ReservationQueue throughput under contention from an equal number of front-desk (producer) and worker
+ * (consumer) threads, next to a ring buffer guarded by a mutex.
+ * Usage: reservation_queue_benchmark [reservations per producer] [max threads per side] [capacity]
+ */
+
+// Small trivially copyable reservation, the queue moves these by value
+struct Reservation {
+    uint32_t patron;
+    uint32_t book;
+    int32_t day;
+};
+
+// Baseline: the same bounded ring with one lock around both ends
+class LockedQueue {
+public:
+    explicit LockedQueue(size_t capacity) : cells_(capacity), head_(0), tail_(0), closed_(false) {}
+
+    bool tryPush(const Reservation& reservation) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tail_ - head_ == cells_.size()) {
+            return false;
+        }
+        cells_[tail_++ % cells_.size()] = reservation;
+        return true;
+    }
+
+    bool tryPop(Reservation& reservation) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tail_ == head_) {
+            return false;
+        }
+        reservation = cells_[head_++ % cells_.size()];
+        return true;
+    }
+
+    bool push(const Reservation& reservation) {
+        while (!tryPush(reservation)) {
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    bool pop(Reservation& reservation) {
+        while (!tryPop(reservation)) {
+            if (closed_.load()) {
+                return tryPop(reservation);
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    void close() { closed_.store(true); }
+
+private:
+    std::vector<Reservation> cells_;
+    std::mutex mutex_;
+    size_t head_;
+    size_t tail_;
+    std::atomic<bool> closed_;
+};
+
+// Returns millions of reservations moved through the queue per second
+template <typename Queue>
+double run(Queue& queue, unsigned int threads, size_t perProducer) {
+    std::atomic<uint64_t> checksum(0);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> consumers;
+    for (unsigned int c = 0; c < threads; ++c) {
+        consumers.emplace_back([&]() {
+            Reservation reservation{};
+            uint64_t local = 0;
+            while (queue.pop(reservation)) {
+                local += reservation.book;
+            }
+            checksum += local;
+        });
+    }
+    std::vector<std::thread> producers;
+    for (unsigned int p = 0; p < threads; ++p) {
+        producers.emplace_back([&, p]() {
+            for (size_t i = 0; i < perProducer; ++i) {
+                queue.push(Reservation{p, static_cast<uint32_t>(i), static_cast<int32_t>(i % 365)});
+            }
+        });
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    queue.close();
+    for (std::thread& consumer : consumers) {
+        consumer.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t expected = static_cast<uint64_t>(threads) * (perProducer * (perProducer - 1) / 2);
+    if (checksum != expected) {
+        std::cout << "\tLOST RESERVATIONS";
+    }
+    return static_cast<double>(threads * perProducer) / seconds / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    size_t perProducer = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    unsigned int maxThreads = argc > 2 ? static_cast<unsigned int>(std::atoi(argv[2]))
+                                       : std::max(1u, std::thread::hardware_concurrency());
+    size_t capacity = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1024;
+
+    std::cout << perProducer << " reservations per producer, capacity " << capacity << std::endl;
+    for (unsigned int threads = 1; threads <= maxThreads; threads *= 2) {
+        ReservationQueue<Reservation> lockFree(capacity);
+        double lockFreeRate = run(lockFree, threads, perProducer);
+        LockedQueue locked(capacity);
+        double lockedRate = run(locked, threads, perProducer);
+        std::cout << threads << " producer(s) / " << threads << " consumer(s):\tlock-free " << lockFreeRate
+                  << " M/s\tmutex " << lockedRate << " M/s" << std::endl;
+    }
+    return 0;
+}
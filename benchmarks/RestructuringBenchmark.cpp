@@ -0,0 +1,107 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <string>
+#include <cstdio>
+#include <unistd.h>
+#include "../include/LibraryRestructuring.h"
+/*
+ * Measures how long LibraryRestructuring takes to build its graph from a synthetic borrow history, from a record set
+ * and from a BorrowRecordTable, what its CSR adjacency costs next to the string keyed graph, and how long clustering it
+ * takes with each clustering mode.
+ * A power user who borrows a given number of distinct books can be added, which turns into a clique in the co-borrow
+ * graph and is skipped for the graph based modes once it would exceed 50M edges.
+ * Usage: restructuring_benchmark [record count] [power user loans]
+ */
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Resident set size from /proc, Linux only
+static double residentMegabytes() {
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    long pages = 0;
+    long resident = 0;
+    if (statm != nullptr) {
+        if (std::fscanf(statm, "%ld %ld", &pages, &resident) != 2) {
+            resident = 0;
+        }
+        std::fclose(statm);
+    }
+    return static_cast<double>(resident) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1 << 20);
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t powerLoans = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0;
+    bool buildGraphs = powerLoans * powerLoans <= 50000000;
+    // About three borrows per patron, and every book borrowed a few times, keeps the graph sparse
+    size_t patronCount = count / 3 + 1;
+    size_t bookCount = count / 4 + 1;
+
+    std::mt19937 generator(8042);
+    UnorderedSet<BorrowRecord> records;
+    BorrowRecordTable table;
+    table.reserve(count);
+    Date origin(2020, 1, 1);
+    for (size_t i = 0; i < count; ++i) {
+        BorrowRecord record;
+        record.patronId = "user" + std::to_string(generator() % patronCount);
+        record.bookISBN = "isbn" + std::to_string(generator() % bookCount);
+        record.checkoutDate = origin + static_cast<int>(generator() % 1400);
+        record.returnDate = record.checkoutDate + static_cast<int>(generator() % 60);
+        table.append(record);
+        records.insert(record);
+    }
+    for (size_t loan = 0; loan < powerLoans; ++loan) {
+        int checkout = origin.getDayNumber() + static_cast<int>(loan % 1400);
+        table.append("school", "isbn" + std::to_string(loan % bookCount), checkout, checkout + 14);
+    }
+    UnorderedSet<Book> books;
+    std::cout << count << " records, " << table.patrons().size() << " patrons, " << table.books().size() << " books"
+              << std::endl;
+
+    std::vector<std::vector<std::string>> clusters;
+    auto start = std::chrono::steady_clock::now();
+    if (buildGraphs) {
+        // The record set leaves the power user out, it only times the record set constructor
+        LibraryRestructuring fromRecords(records, books);
+        std::cout << "build from records:\t" << secondsSince(start) << " s" << std::endl;
+
+        start = std::chrono::steady_clock::now();
+        LibraryRestructuring fromTable(table, books);
+        std::cout << "build from table:\t" << secondsSince(start) << " s" << std::endl;
+
+        start = std::chrono::steady_clock::now();
+        CsrGraph graph = CsrGraph::coBorrowGraph(table);
+        std::cout << "CSR graph:\t\t" << secondsSince(start) << " s, " << graph.edgeCount() << " edges, "
+                  << graph.memoryBytes() / double(1 << 20) << " MB" << std::endl;
+
+        double resident = residentMegabytes();
+        start = std::chrono::steady_clock::now();
+        fromRecords.getGraph();
+        std::cout << "string graph:\t\t" << secondsSince(start) << " s, " << residentMegabytes() - resident << " MB"
+                  << std::endl;
+
+        start = std::chrono::steady_clock::now();
+        clusters = fromTable.clusterAndSort("title");
+        std::cout << "cluster and sort:\t" << secondsSince(start) << " s, " << clusters.size() << " clusters"
+                  << std::endl;
+    }
+
+    start = std::chrono::steady_clock::now();
+    LibraryRestructuring unionFind(table, books, LibraryRestructuring::ClusteringMode::UNION_FIND);
+    std::vector<std::vector<std::string>> unionClusters = unionFind.clusterAndSort("title");
+    bool same = !buildGraphs || unionClusters == clusters;
+    std::cout << "union-find build + cluster:\t" << secondsSince(start) << " s" << (same ? "" : "\tCLUSTERS DIFFER")
+              << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    LibraryRestructuring bipartite(table, books, LibraryRestructuring::ClusteringMode::BIPARTITE);
+    same = bipartite.clusterAndSort("title") == unionClusters;
+    std::cout << "bipartite build + cluster:\t" << secondsSince(start) << " s" << (same ? "" : "\tCLUSTERS DIFFER")
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "../include/LibraryRestructuring.h"
+/*
+ * Compares a cold start that rebuilds LibraryRestructuring from borrow records with one that maps a snapshot saved
+ * from it, and checks that both produce the same clusters.
+ * Usage: snapshot_benchmark [record count] [path]
+ */
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    std::string path = argc > 2 ? argv[2] : "/tmp/library_snapshot_benchmark.bin";
+
+    std::mt19937 generator(8042);
+    size_t bookCount = count / 4 + 1;
+    size_t patronCount = count / 3 + 1;
+    UnorderedSet<Book> books;
+    for (size_t i = 0; i < bookCount; ++i) {
+        std::string isbn = "isbn" + std::to_string(i);
+        std::string title = "title" + std::to_string(generator() % bookCount);
+        std::string author = "author" + std::to_string(generator() % 5000);
+        std::string publisher = "publisher";
+        std::string year = std::to_string(1900 + generator() % 120);
+        std::string copies = "1";
+        books.insert(Book(isbn, title, author, publisher, year, copies));
+    }
+    // A few borrows per patron keeps the graph sparse
+    BorrowRecordTable table;
+    int origin = Date(2020, 1, 1).getDayNumber();
+    for (size_t i = 0; i < count; ++i) {
+        std::string patron = "user" + std::to_string(generator() % patronCount);
+        std::string isbn = "isbn" + std::to_string(generator() % bookCount);
+        int checkout = origin + static_cast<int>(generator() % 1400);
+        table.append(patron, isbn, checkout, checkout + static_cast<int>(generator() % 60));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    LibraryRestructuring built(table, books);
+    std::vector<std::vector<std::string>> expected = built.clusterAndSort("title");
+    double buildSeconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    built.saveSnapshot(path);
+    double saveSeconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    LibraryRestructuring mapped = LibraryRestructuring::fromSnapshot(path);
+    double openSeconds = secondsSince(start);
+    std::vector<std::vector<std::string>> clusters = mapped.clusterAndSort("title");
+    double mappedSeconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    LibraryRestructuring trusted = LibraryRestructuring::fromSnapshot(path, false);
+    double trustedSeconds = secondsSince(start);
+
+    std::cout << count << " records, " << expected.size() << " clusters" << std::endl;
+    std::cout << "build + cluster:\t" << buildSeconds << " s" << std::endl;
+    std::cout << "save snapshot:\t\t" << saveSeconds << " s" << std::endl;
+    std::cout << "open (verified):\t" << openSeconds << " s" << std::endl;
+    std::cout << "open (trusted):\t\t" << trustedSeconds << " s" << std::endl;
+    std::cout << "open + cluster:\t\t" << mappedSeconds << " s"
+              << (clusters == expected ? "" : "\tCLUSTERS DIFFER") << std::endl;
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,65 @@
+#ifndef AVAILABILITYCALENDAR_H
+#define AVAILABILITYCALENDAR_H
+/**
+ * Implementation of a per-book availability calendar over day numbers.
+ */
+#include <vector>
+#include <cstdint>
+#include "Date.h"
+
+// Tracks how many copies of a book are out on every day. Changes are stored in a segment tree over a window of days
+// that holds, per node, the change applied to its whole range plus the lowest and highest value inside it, so adding
+// to a range of days and finding the lowest or highest value in a range are all O(log D). Nodes are only created on
+// the paths that an add walks, and widening the window puts a new root above the old one, so memory grows with the
+// number of adds rather than with the number of days: an outlier date such as year 1 or 9999 costs a few dozen nodes.
+// An untouched calendar allocates nothing.
+class AvailabilityCalendar {
+public:
+    AvailabilityCalendar() : origin_(0), size_(0) {}
+
+    // Adds delta to every day in [from, to] (e.g. -1 while a copy is checked out)
+    void add(const Date& from, const Date& to, int delta);
+    // Sum of the changes made on a single day
+    int changeOn(const Date& date) const;
+    // Lowest sum of changes on any day in [from, to]
+    int lowestChangeBetween(const Date& from, const Date& to) const;
+    // Highest sum of changes on any day in [from, to]
+    int highestChangeBetween(const Date& from, const Date& to) const;
+    // Whether nothing has been recorded yet
+    bool empty() const { return size_ == 0; }
+    // Number of tree nodes allocated so far
+    size_t nodeCount() const { return tree.size(); }
+
+private:
+    // First day covered by the tree
+    int64_t origin_;
+    // Number of days covered, a power of two
+    int64_t size_;
+    struct Node {
+        // Change applied to every day under the node
+        int add;
+        // Lowest and highest change of any day under the node, including the node's own add
+        int lowest;
+        int highest;
+        // Index of the left child, the right one follows it; 0 while every day under the node has the same value
+        uint32_t children;
+    };
+    // Node 0 is the root, which covers [origin_, origin_ + size_)
+    std::vector<Node> tree;
+
+    // Widens the window to cover [lo, hi) by adding roots, every existing node keeps its value
+    void grow(int64_t lo, int64_t hi);
+    // Adds delta to every day under a node
+    static void shift(Node& node, int delta);
+    // Adds delta to the days of [lo, hi) under the node covering [begin, begin + size)
+    void update(uint32_t node, int64_t begin, int64_t size, int64_t lo, int64_t hi, int delta);
+    // Lowest (or highest) value in [lo, hi) under the node covering [begin, begin + size), which the range overlaps
+    template <bool Highest>
+    int query(uint32_t node, int64_t begin, int64_t size, int64_t lo, int64_t hi) const;
+    template <bool Highest>
+    int changeBetween(const Date& from, const Date& to) const;
+};
+
+#include "../src/AvailabilityCalendar.cpp"
+
+#endif //AVAILABILITYCALENDAR_H
@@ -0,0 +1,67 @@
+#ifndef BOOKCATALOG_H
+#define BOOKCATALOG_H
+/**
+ * Implementation of a compact book catalog whose text lives in one string arena.
+ */
+#include <vector>
+#include <string_view>
+#include <cstdint>
+#include <limits>
+#include "Utils.h"
+#include "UnorderedSet.h"
+#include "StringArena.h"
+#include "StringInterner.h"
+
+// Index of a book in its BookCatalog
+using BookRef = uint32_t;
+
+// A catalog book. The text fields point into the catalog's arena and stay valid as long as the catalog does; the
+// year is parsed once when the book is added, and its text is kept as given.
+struct BookView {
+    std::string_view ISBN;
+    std::string_view title;
+    std::string_view author;
+    std::string_view publisher;
+    // Year published as it was added, such as "c. 1850" or "0999", which yearPublished cannot represent
+    std::string_view yearText;
+    int yearPublished;
+    int copies;
+};
+
+// Books indexed by ISBN, stored as BookViews over a shared StringArena instead of five heap strings each
+class BookCatalog {
+public:
+    static constexpr BookRef NOT_FOUND = StringInterner::NOT_FOUND;
+    // Year of a book whose yearPublished is not a number; sorts before every real year
+    static constexpr int UNKNOWN_YEAR = std::numeric_limits<int>::min();
+
+    explicit BookCatalog(size_t expectedSize = 16);
+    explicit BookCatalog(const UnorderedSet<Book>& books);
+
+    // Adds a book and returns its reference; a repeated ISBN keeps the book added first and returns its reference
+    BookRef add(std::string_view isbn, std::string_view title, std::string_view author, std::string_view publisher,
+                std::string_view yearPublished, int copies);
+    BookRef add(const Book& book);
+    // Reference of the book with this ISBN, or NOT_FOUND
+    BookRef find(std::string_view isbn) const { return isbns_.lookup(isbn); }
+    const BookView& operator[](BookRef book) const { return books_[book]; }
+    size_t size() const { return books_.size(); }
+    bool empty() const { return books_.empty(); }
+    std::vector<BookView>::const_iterator begin() const { return books_.begin(); }
+    std::vector<BookView>::const_iterator end() const { return books_.end(); }
+    // Bytes of text held in the arena
+    size_t textBytes() const { return arena_.bytes(); }
+
+    // The year as an integer, UNKNOWN_YEAR if it is not one
+    static int parseYear(std::string_view yearPublished);
+
+private:
+    StringArena arena_;
+    // ISBN ids double as book references, since a book is appended exactly when its ISBN is first interned
+    StringInterner isbns_;
+    std::vector<BookView> books_;
+};
+
+#include "../src/BookCatalog.cpp"
+
+#endif //BOOKCATALOG_H
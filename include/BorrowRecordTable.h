@@ -0,0 +1,73 @@
+#ifndef BORROWRECORDTABLE_H
+#define BORROWRECORDTABLE_H
+/**
+ * Implementation of a columnar (struct-of-arrays) store of borrow records.
+ */
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include "Date.h"
+#include "Utils.h"
+#include "UnorderedSet.h"
+#include "StringInterner.h"
+
+// Borrow records kept as four contiguous columns: interned patron id, interned book id, checkout and return day
+// numbers. Aggregations stream through the one or two columns they need instead of visiting whole records, and the
+// plain loops over them are left for the compiler to vectorise.
+class BorrowRecordTable {
+public:
+    enum class Column { PATRON, BOOK, CHECKOUT, RETURN };
+
+    BorrowRecordTable() = default;
+    explicit BorrowRecordTable(const UnorderedSet<BorrowRecord>& records);
+
+    void reserve(size_t rows);
+    // Adds a record, interning its patron and ISBN
+    void append(const BorrowRecord& record);
+    void append(std::string_view patronId, std::string_view bookISBN, DayNumber checkoutDay, DayNumber returnDay);
+    // Adds a record whose ids were already interned in patrons() and books()
+    void appendIds(uint32_t patron, uint32_t book, DayNumber checkoutDay, DayNumber returnDay);
+    size_t size() const { return patronIds_.size(); }
+    // Rebuilds the record stored in a row
+    BorrowRecord record(size_t row) const;
+
+    // Stable radix sort of every row on one column; ids sort in the order they were interned
+    void sortBy(Column column);
+    // Rows in ascending order of a column, stable, without moving the table
+    std::vector<uint32_t> orderBy(Column column) const;
+
+    const std::vector<uint32_t>& patronIds() const { return patronIds_; }
+    const std::vector<uint32_t>& bookIds() const { return bookIds_; }
+    const std::vector<DayNumber>& checkoutDays() const { return checkoutDays_; }
+    const std::vector<DayNumber>& returnDays() const { return returnDays_; }
+    const StringInterner& patrons() const { return patrons_; }
+    const StringInterner& books() const { return books_; }
+    StringInterner& patrons() { return patrons_; }
+    StringInterner& books() { return books_; }
+
+    // Sum of (return - checkout) over every row
+    long long totalBorrowingTime() const;
+    // Sum of (return - checkout) per book id
+    std::vector<long long> borrowingTimeByBook() const;
+    // Number of rows per patron id
+    std::vector<uint32_t> recordCountByPatron() const;
+    // Number of rows whose borrow covers the day, both ends included
+    size_t activeOn(DayNumber day) const;
+
+private:
+    std::vector<uint32_t> patronIds_;
+    std::vector<uint32_t> bookIds_;
+    std::vector<DayNumber> checkoutDays_;
+    std::vector<DayNumber> returnDays_;
+    StringInterner patrons_;
+    StringInterner books_;
+
+    // Reorders every column so that row i takes the values of row order[i]
+    template <typename Value>
+    static void permute(std::vector<Value>& column, const std::vector<uint32_t>& order);
+};
+
+#include "../src/BorrowRecordTable.cpp"
+
+#endif //BORROWRECORDTABLE_H
@@ -0,0 +1,81 @@
+#ifndef CIRCULATIONENGINE_H
+#define CIRCULATIONENGINE_H
+/**
+ * Implementation of a batch checkout/return processing engine.
+ */
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Utils.h"
+#include "UnorderedSet.h"
+#include "HashTable.h"
+#include "StringInterner.h"
+#include "LExceptions.h"
+
+// Outcome of processing a single borrow record
+enum class CirculationStatus : uint8_t {
+    OK,
+    // The checkout date is after the return date
+    INVALID_DATES,
+    // The ISBN is not in the catalog
+    UNKNOWN_BOOK,
+    // No copy is free on every day of the borrow
+    UNAVAILABLE,
+    // A return that matches no outstanding checkout of the same patron, book and dates
+    NOT_CHECKED_OUT
+};
+
+// Processes checkouts and returns against a catalog of books. The batch and single-record calls report rejected
+// records as status codes, which cost the same as accepted ones; they only throw std::bad_alloc when the calendars,
+// the loan ledger or the status vector cannot grow. The throwing calls map the status codes onto the exceptions in
+// LExceptions.h for callers at the API boundary.
+class CirculationEngine {
+public:
+    explicit CirculationEngine(const UnorderedSet<Book>& catalog);
+
+    // Checks out one copy of the record's book for every day from checkout to return (inclusive)
+    CirculationStatus checkout(const BorrowRecord& record);
+    // Returns the copy taken out by an accepted checkout of the same patron, book and dates
+    CirculationStatus returnBook(const BorrowRecord& record);
+    // Processes the records in order, writing one status per record, and returns how many succeeded
+    size_t checkoutBatch(const std::vector<BorrowRecord>& records, std::vector<CirculationStatus>& statuses);
+    size_t returnBatch(const std::vector<BorrowRecord>& records, std::vector<CirculationStatus>& statuses);
+
+    // Same as checkout/returnBook but throw InvalidBorrowRecordDates, UnavailableBookToBorrow or
+    // std::invalid_argument when the record is rejected
+    void checkoutOrThrow(const BorrowRecord& record);
+    void returnOrThrow(const BorrowRecord& record);
+
+    // Book with the given ISBN, or nullptr when it is not in the catalog
+    const Book* findBook(const std::string& ISBN);
+    // Number of copies of a book that are free on a date, -1 for an unknown ISBN
+    int copiesOnDate(const std::string& ISBN, const Date& date);
+    size_t size() const { return books.size(); }
+
+private:
+    // Books in catalog order, so that a slot is stable for the lifetime of the engine
+    std::vector<Book> books;
+    // ISBN to slot in books
+    HashTable<std::string, size_t> slots;
+    // Slot of the last ISBN looked up, batches often hold runs of the same book
+    std::string lastISBN;
+    size_t lastSlot;
+    // Ledger of accepted checkouts: every (book slot, checkout day, return day, patron) seen so far gets an id, and
+    // outstanding holds how many of its loans are not returned yet
+    StringInterner loans;
+    std::vector<uint32_t> outstanding;
+    // Reused buffer for the ledger key of the record being processed
+    std::string loanKey;
+
+    // Slot of an ISBN, or books.size() when it is not in the catalog
+    size_t slotOf(const std::string& ISBN);
+    // Writes the ledger key of a record for a book slot into loanKey
+    void buildLoanKey(const BorrowRecord& record, size_t slot);
+    CirculationStatus process(const BorrowRecord& record, bool isCheckout);
+    // Throws the exception matching a status, does nothing for OK
+    void throwFor(CirculationStatus status, const BorrowRecord& record);
+};
+
+#include "../src/CirculationEngine.cpp"
+
+#endif //CIRCULATIONENGINE_H
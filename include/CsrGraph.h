@@ -0,0 +1,54 @@
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+/**
+ * Implementation of an immutable compressed sparse row (CSR) graph over integer vertex ids.
+ */
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "BorrowRecordTable.h"
+
+// Vertices are dense ids 0..vertexCount()-1. The neighbours of v are targets()[offsets()[v]] up to
+// targets()[offsets()[v + 1]], one packed array for the whole graph, optionally with a weight per edge. Targets are
+// plain ids and may name vertices of another set, as in the patron to book incidence.
+class CsrGraph {
+public:
+    CsrGraph() : offsets_(1, 0) {}
+    // Takes over ready-made arrays, throws std::invalid_argument unless offsets start at 0, never decrease and end at
+    // targets.size(), and weights is empty or has one entry per target
+    CsrGraph(std::vector<uint64_t> offsets, std::vector<uint32_t> targets, std::vector<uint32_t> weights = {});
+
+    // Patron to book incidence of a table: the neighbours of patron id p are the distinct book ids p borrowed, in the
+    // order of their first borrow
+    static CsrGraph patronBooks(const BorrowRecordTable& records);
+    // Co-borrow graph over the table's book ids: two books are neighbours when some patron borrowed both. A count
+    // pass sizes every adjacency and a fill pass writes it, both walking book -> patrons -> books and marking the
+    // books already seen from the current one. With weighted set, every edge carries the number of patrons who
+    // borrowed both books.
+    static CsrGraph coBorrowGraph(const BorrowRecordTable& records, bool weighted = false);
+    // The same edges reversed, over targetCount vertices; sources come out in ascending order for every target
+    CsrGraph transpose(uint32_t targetCount) const;
+
+    uint32_t vertexCount() const { return static_cast<uint32_t>(offsets_.size() - 1); }
+    uint64_t edgeCount() const { return targets_.size(); }
+    uint64_t degree(uint32_t vertex) const { return offsets_[vertex + 1] - offsets_[vertex]; }
+    const uint32_t* begin(uint32_t vertex) const { return targets_.data() + offsets_[vertex]; }
+    const uint32_t* end(uint32_t vertex) const { return targets_.data() + offsets_[vertex + 1]; }
+    bool weighted() const { return !weights_.empty(); }
+    // Weight of the edge at a position of targets(), 1 when the graph is unweighted
+    uint32_t weight(uint64_t edge) const { return weights_.empty() ? 1 : weights_[edge]; }
+    const std::vector<uint64_t>& offsets() const { return offsets_; }
+    const std::vector<uint32_t>& targets() const { return targets_; }
+    const std::vector<uint32_t>& weights() const { return weights_; }
+    // Bytes held by the three arrays
+    size_t memoryBytes() const;
+
+private:
+    std::vector<uint64_t> offsets_;
+    std::vector<uint32_t> targets_;
+    std::vector<uint32_t> weights_;
+};
+
+#include "../src/CsrGraph.cpp"
+
+#endif //CSRGRAPH_H
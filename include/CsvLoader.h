@@ -0,0 +1,84 @@
+#ifndef CSVLOADER_H
+#define CSVLOADER_H
+/**
+ * Implementation of a zero-copy, memory-mapped CSV loader for the library circulation data.
+ */
+#include <vector>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <cstddef>
+#include "Utils.h"
+#include "BorrowRecordTable.h"
+#include "MappedFile.h"
+#include "BookCatalog.h"
+
+// A field as it appears in the text, without its surrounding quotes. Escaped fields still hold their doubled quotes,
+// which are only removed when the field is copied out.
+struct CsvField {
+    std::string_view text;
+    bool escaped;
+
+    // Appends the field's value to out
+    void appendTo(std::string& out) const;
+    // The field's value, as a view into the text unless it has to be unescaped into scratch
+    std::string_view value(std::string& scratch) const;
+};
+
+// Splits RFC 4180 text into records and fields in place: commas and line breaks inside quotes belong to the field, a
+// doubled quote inside quotes is a literal quote, and both "\n" and "\r\n" end a record. Blank lines are skipped.
+class CsvReader {
+public:
+    explicit CsvReader(std::string_view text) : cursor_(text.data()), end_(text.data() + text.size()) {}
+
+    // Fills fields with the next record, returns false once the text is exhausted
+    bool next(std::vector<CsvField>& fields);
+    // Offset of the first byte not yet read
+    size_t offset(std::string_view text) const { return static_cast<size_t>(cursor_ - text.data()); }
+
+    // Cuts text into at most count consecutive ranges of roughly equal size that each start at a record. A single
+    // memchr-driven pass tracks, with the quoting rules of next(), whether each candidate cut falls inside a quoted field.
+    static std::vector<std::pair<size_t, size_t>> splitRecords(std::string_view text, size_t count);
+
+private:
+    const char* cursor_;
+    const char* end_;
+};
+
+// Loads books, patrons and borrow records from CSV files with a header row and the columns in the order the
+// Book, Patron and BorrowRecord constructors take them. The file is mapped, not read, fields are views into the map
+// until they are copied into the objects, and with more than one thread the file is split at record boundaries and
+// the chunks are parsed concurrently. Malformed records throw std::runtime_error.
+class CsvLoader {
+public:
+    explicit CsvLoader(const std::string& path, unsigned int threadCount = 1, bool hasHeader = true);
+
+    // ISBN, title, author, publisher, yearPublished, copies
+    std::vector<Book> books() const;
+    // Same columns as books, copied once into a catalog's arena without building a Book per record
+    BookCatalog bookCatalog() const;
+    // ID, name, email, location, age ("-" when unknown)
+    std::vector<Patron> patrons() const;
+    // patronId, bookISBN, checkoutDate, returnDate (YYYY-MM-DD)
+    std::vector<BorrowRecord> borrowRecords() const;
+    // Same columns as borrowRecords, interned straight into a table
+    BorrowRecordTable borrowRecordTable() const;
+
+private:
+    MappedFile file_;
+    unsigned int threadCount_;
+    // Where the first data record starts
+    size_t bodyOffset_;
+
+    // Runs parse(reader, rows) over every chunk of the body on its own thread and returns the rows chunk by chunk
+    template <typename Row, typename Parse>
+    std::vector<std::vector<Row>> parseChunks(Parse parse) const;
+    // Throws if a record has too few fields
+    static void requireFields(const std::vector<CsvField>& fields, size_t count, const char* kind);
+    static int parseInt(const CsvField& field, const char* kind);
+    static Date parseDate(const CsvField& field);
+};
+
+#include "../src/CsvLoader.cpp"
+
+#endif //CSVLOADER_H
@@ -7,19 +7,43 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <stdexcept>
+#include <functional>
 // IMPORT ID: 1
-// This class is already implemented and does not require any modification!
+
+// Result of parsing a date without exceptions
+enum class DateParseError { NONE, BAD_FORMAT, BAD_MONTH, BAD_DAY };
+
+// Days since 1970-01-01 in the proleptic Gregorian calendar, negative before it.
+using DayNumber = int32_t;
+
 class Date {
 public:
-    Date(int year, int month, int day) : year_(year), month_(month), day_(day) {}
+    // Throws std::invalid_argument for a month or day that does not exist rather than rolling it into the next one
+    Date(int year, int month, int day) : days_(daysFromCivil(year, month, day)) {
+        if (validate(year, month, day) != DateParseError::NONE) {
+            throw std::invalid_argument("Invalid date. The month or day does not exist.");
+        }
+    }
 
-    int getYear() const { return year_; }
-    int getMonth() const { return month_; }
-    int getDay() const { return day_; }
+    // O(1) conversions between a date and its day number
+    static Date fromDayNumber(DayNumber days) {
+        Date date;
+        date.days_ = days;
+        return date;
+    }
+    DayNumber getDayNumber() const { return days_; }
+
+    int getYear() const { return toCivil().year; }
+    int getMonth() const { return toCivil().month; }
+    int getDay() const { return toCivil().day; }
 
     // Comparison operators for range-based for loop
     bool operator==(const Date& other) const {
-        return year_ == other.year_ && month_ == other.month_ && day_ == other.day_;
+        return days_ == other.days_;
     }
 
     bool operator!=(const Date& other) const {
@@ -27,9 +51,7 @@ public:
     }
 
     bool operator<=(const Date& other) const {
-        if (year_ != other.year_) return year_ < other.year_;
-        if (month_ != other.month_) return month_ < other.month_;
-        return day_ <= other.day_;
+        return days_ <= other.days_;
     }
 
     bool operator>(const Date& other) const {
@@ -44,96 +66,191 @@ public:
         return !(*this >= other);
     }
 
+    // Day arithmetic
+    Date operator+(int days) const {
+        return fromDayNumber(days_ + days);
+    }
+
+    Date operator-(int days) const {
+        return fromDayNumber(days_ - days);
+    }
+
+    int operator-(const Date& other) const {
+        return days_ - other.days_;
+    }
+
     size_t getHash() const {
-        return internalHash(*this);
+        return Date::Hash{}(*this);
     }
 
     struct Hash {
         size_t operator()(const Date& date) const {
-            return (static_cast<size_t>(date.year_) << 9) | (static_cast<size_t>(date.month_) << 5) | static_cast<size_t>(date.day_);
+            return std::hash<DayNumber>{}(date.days_);
         }
     };
 
     static Date parseDate(const std::string& dateString) {
-        int year, month, day;
-        char dash1, dash2;
-        std::istringstream iss(dateString);
-        iss >> year >> dash1 >> month >> dash2 >> day;
-
-        if (iss.fail() || dash1 != '-' || dash2 != '-') {
+        Date date;
+        if (tryParseDate(dateString, date) != DateParseError::NONE) {
             throw std::invalid_argument("Invalid date format. Expected YYYY-MM-DD.");
         }
-        return {year, month, day};
+        return date;
     }
 
-    static Date getNextDate(const Date& currentDate) {
-        int year = currentDate.getYear();
-        int month = currentDate.getMonth();
-        int day = currentDate.getDay();
-
-        // Calculate the next date based on the current date
-        // You need to handle month overflow and leap years here
-        // For simplicity, let's assume all months have 30 days and ignore leap years.
-        day++;
-        if (day > 30) {
-            day = 1;
-            month++;
-            if (month > 12) {
-                month = 1;
-                year++;
+    // Parses YYYY-MM-DD (month and day may also be a single digit) without allocating or throwing. date is only
+    // written when NONE is returned.
+    static DateParseError tryParseDate(std::string_view text, Date& date) {
+        const char* cursor = text.data();
+        const char* end = cursor + text.size();
+        int year = 0;
+        int month = 0;
+        int day = 0;
+        if (!parseField(cursor, end, 4, year) || cursor == end || *cursor++ != '-' ||
+            !parseField(cursor, end, 2, month) || cursor == end || *cursor++ != '-' ||
+            !parseField(cursor, end, 2, day) || cursor != end) {
+            return DateParseError::BAD_FORMAT;
+        }
+        DateParseError error = validate(year, month, day);
+        if (error == DateParseError::NONE) {
+            date.days_ = daysFromCivil(year, month, day);
+        }
+        return error;
+    }
+
+    // Parses count fixed-width YYYY-MM-DD dates laid out stride bytes apart (e.g. a column of fixed-width rows),
+    // converting the eight YYYY-MM- bytes of each with SWAR arithmetic on one 64-bit word. Writes the day number
+    // of every date to days (0 for invalid ones) and, if given, every result to errors. Returns the number of
+    // invalid dates.
+    static size_t parseDateColumn(const char* column, size_t count, size_t stride, DayNumber* days,
+                                  DateParseError* errors = nullptr) {
+        size_t invalid = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const char* text = column + i * stride;
+            int year;
+            int month;
+            int day;
+            DateParseError error = DateParseError::BAD_FORMAT;
+            if (parseFixedWidth(text, year, month, day)) {
+                error = validate(year, month, day);
+            }
+            days[i] = error == DateParseError::NONE ? daysFromCivil(year, month, day) : 0;
+            if (errors != nullptr) {
+                errors[i] = error;
             }
+            invalid += error != DateParseError::NONE;
         }
+        return invalid;
+    }
 
-        return {year, month, day};
+    static Date getNextDate(const Date& currentDate) {
+        return currentDate + 1;
     }
 
     static int diffDuration(const Date& startDate, const Date& endDate) {
-        if (startDate.getYear() == endDate.getYear() && startDate.getMonth() == endDate.getMonth() &&
-            startDate.getDay() == endDate.getDay()) {
-            return 0;
-        } else if (startDate.getYear() == endDate.getYear() && startDate.getMonth() == endDate.getMonth()) {
-            return endDate.getDay() - startDate.getDay();
-        }
+        return endDate - startDate;
+    }
 
-        int daysInMonth[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+private:
+    struct Civil {
+        int year;
+        int month;
+        int day;
+    };
 
-        int startYear = startDate.getYear();
-        int startMonth = startDate.getMonth();
-        int startDay = startDate.getDay();
+    DayNumber days_;
 
-        int endYear = endDate.getYear();
-        int endMonth = endDate.getMonth();
-        int endDay = endDate.getDay();
+    Date() : days_(0) {}
 
-        int days = 0;
+    // Reads 1 to maxDigits decimal digits into value
+    static bool parseField(const char*& cursor, const char* end, int maxDigits, int& value) {
+        const char* start = cursor;
+        value = 0;
+        while (cursor != end && cursor - start < maxDigits && *cursor >= '0' && *cursor <= '9') {
+            value = value * 10 + (*cursor++ - '0');
+        }
+        return cursor != start;
+    }
 
-        for (int year = startYear; year < endYear; ++year) {
-            days += 365;
-            if ((year % 4 == 0 && year % 100 != 0) || (year % 400 == 0))
-                days += 1; // Leap year
+    static DateParseError validate(int year, int month, int day) {
+        static const int daysInMonth[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        if (month < 1 || month > 12) {
+            return DateParseError::BAD_MONTH;
+        }
+        bool leapYear = (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
+        if (day < 1 || day > daysInMonth[month] + (month == 2 && leapYear)) {
+            return DateParseError::BAD_DAY;
         }
+        return DateParseError::NONE;
+    }
 
-        if (startDate.getMonth() == endDate.getMonth())
-            return days + (endDate.getDay() - startDate.getDay());
+    // Parses exactly ten YYYY-MM-DD bytes. The first eight are loaded as one little-endian word: the high nibble of
+    // every digit byte must be 3 both before and after adding 6 (so the byte is '0'..'9'), and digit pairs are then
+    // combined in place with a single multiply-add.
+    static bool parseFixedWidth(const char* text, int& year, int& month, int& day) {
+        static const bool littleEndian = [] {
+            const uint16_t probe = 1;
+            unsigned char first;
+            std::memcpy(&first, &probe, 1);
+            return first == 1;
+        }();
+        if (!littleEndian) {
+            for (int i : {0, 1, 2, 3, 5, 6, 8, 9}) {
+                if (text[i] < '0' || text[i] > '9') {
+                    return false;
+                }
+            }
+            year = (text[0] - '0') * 1000 + (text[1] - '0') * 100 + (text[2] - '0') * 10 + (text[3] - '0');
+            month = (text[5] - '0') * 10 + (text[6] - '0');
+            day = (text[8] - '0') * 10 + (text[9] - '0');
+            return text[4] == '-' && text[7] == '-';
+        }
 
-        if ((endYear % 4 == 0 && endYear % 100 != 0) || (endYear % 400 == 0))
-            daysInMonth[2] = 29;
+        const uint64_t digitBytes = 0x00FFFF00FFFFFFFFull;
+        const uint64_t dashes = 0x2D00002D00000000ull;
+        uint64_t word;
+        std::memcpy(&word, text, sizeof(word));
+        if ((word & ~digitBytes) != dashes ||
+            (word & 0xF0F0F0F0F0F0F0F0ull & digitBytes) != (0x3030303030303030ull & digitBytes) ||
+            ((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull & digitBytes) !=
+            (0x3030303030303030ull & digitBytes)) {
+            return false;
+        }
+        uint64_t digits = word & 0x000F0F000F0F0F0Full;
+        uint64_t pairs = digits * 10 + (digits >> 8);
+        year = static_cast<int>((pairs & 0xFF) * 100 + ((pairs >> 16) & 0xFF));
+        month = static_cast<int>((pairs >> 40) & 0xFF);
 
-        for (int month = startMonth; month <= endMonth; ++month) {
-            if (month == startMonth)
-                days += daysInMonth[month] - startDay; // Days in start month
-            else if (month == endMonth)
-                days += endDay; // Days in end month
-            else
-                days += daysInMonth[month]; // Days in months between start and end
+        if (text[8] < '0' || text[8] > '9' || text[9] < '0' || text[9] > '9') {
+            return false;
         }
-        return days;
+        day = (text[8] - '0') * 10 + (text[9] - '0');
+        return true;
     }
 
-private:
-    int year_;
-    int month_;
-    int day_;
-    Date::Hash internalHash;
+    // Howard Hinnant's days_from_civil: counts 400-year eras of 146097 days from a year starting on March 1st
+    static DayNumber daysFromCivil(int year, int month, int day) {
+        year -= month <= 2;
+        const int era = (year >= 0 ? year : year - 399) / 400;
+        const unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+        const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + static_cast<int>(dayOfEra) - 719468;
+    }
+
+    // The inverse, civil_from_days
+    Civil toCivil() const {
+        const int days = days_ + 719468;
+        const int era = (days >= 0 ? days : days - 146096) / 146097;
+        const unsigned dayOfEra = static_cast<unsigned>(days - era * 146097);
+        const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const unsigned shiftedMonth = (5 * dayOfYear + 2) / 153;
+        const int day = static_cast<int>(dayOfYear - (153 * shiftedMonth + 2) / 5 + 1);
+        const int month = static_cast<int>(shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9);
+        const int year = static_cast<int>(yearOfEra) + era * 400 + (month <= 2);
+        return {year, month, day};
+    }
 };
+
+static_assert(sizeof(Date) == sizeof(DayNumber), "Date must stay a packed day number.");
 #endif //DATE_H
@@ -0,0 +1,37 @@
+#ifndef DENSEBITSET_H
+#define DENSEBITSET_H
+/**
+ * Implementation of a fixed-size bitset over dense integer ids.
+ */
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// One bit per id packed into 64-bit words. Takes the same memory as std::vector<bool>, but exposes the words: a visit
+// check and mark is one testAndSet, count() and clear() go a word at a time, and bits are plain bools rather than
+// proxy references
+class DenseBitset {
+public:
+    explicit DenseBitset(size_t size = 0) : words_((size + 63) / 64, 0), size_(size) {}
+
+    size_t size() const { return size_; }
+    bool test(size_t bit) const { return (words_[bit >> 6] >> (bit & 63)) & 1; }
+    void set(size_t bit) { words_[bit >> 6] |= uint64_t(1) << (bit & 63); }
+    void reset(size_t bit) { words_[bit >> 6] &= ~(uint64_t(1) << (bit & 63)); }
+    // Sets the bit and returns whether it was already set
+    bool testAndSet(size_t bit);
+    // Clears every bit
+    void clear();
+    // Grows or shrinks to size bits, new bits are clear
+    void resize(size_t size);
+    // Number of set bits
+    size_t count() const;
+
+private:
+    std::vector<uint64_t> words_;
+    size_t size_;
+};
+
+#include "../src/DenseBitset.cpp"
+
+#endif //DENSEBITSET_H
@@ -0,0 +1,37 @@
+#ifndef DISJOINTSET_H
+#define DISJOINTSET_H
+/**
+ * Implementation of a disjoint-set (union-find) forest over dense integer ids.
+ */
+#include <vector>
+#include <cstdint>
+
+// Union by size keeps every tree O(log n) deep and find compresses the path it walks, so a sequence of m operations
+// runs in O(m α(n)). Elements are ids 0..size()-1; add() appends a new singleton so that ids can be streamed in.
+class DisjointSet {
+public:
+    explicit DisjointSet(uint32_t count = 0);
+
+    // Appends a singleton and returns its id
+    uint32_t add();
+    // Grows to at least count elements
+    void resize(uint32_t count);
+    // Representative of the set holding element
+    uint32_t find(uint32_t element);
+    // Merges the sets of a and b, false if they were already one set
+    bool unite(uint32_t a, uint32_t b);
+    // Number of elements in the set holding element
+    uint32_t sizeOf(uint32_t element) { return size_[find(element)]; }
+    uint32_t size() const { return static_cast<uint32_t>(parent_.size()); }
+    uint32_t componentCount() const { return components_; }
+
+private:
+    std::vector<uint32_t> parent_;
+    // Set size, kept up to date at roots only
+    std::vector<uint32_t> size_;
+    uint32_t components_;
+};
+
+#include "../src/DisjointSet.cpp"
+
+#endif //DISJOINTSET_H
@@ -0,0 +1,164 @@
+#ifndef EXTERNALMERGESORT_H
+#define EXTERNALMERGESORT_H
+/**
+ * Implementation of an external k-way merge sort for data sets which do not fit in memory.
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <functional>
+#include <type_traits>
+#include "Utils.h"
+#include "MergeSort.h"
+
+// Sequential, buffered writer over a (temporary) file.
+class RunWriter {
+public:
+    RunWriter(std::FILE* file, size_t bufferSize) : file(file), buffer(bufferSize), used(0) {}
+    void writeBytes(const void* data, size_t length);
+    void writeVarint(uint64_t value);
+    void flush();
+
+private:
+    std::FILE* file;
+    std::vector<char> buffer;
+    size_t used;
+};
+
+// Sequential, buffered reader over a (temporary) file.
+class RunReader {
+public:
+    RunReader(std::FILE* file, size_t bufferSize) : file(file), buffer(bufferSize), used(0), available(0) {}
+    bool readBytes(void* data, size_t length);
+    bool readVarint(uint64_t& value);
+
+private:
+    std::FILE* file;
+    std::vector<char> buffer;
+    size_t used;
+    size_t available;
+    bool refill();
+};
+
+// Compact binary encoding of the sorted elements in run files. Specialize it for any type that needs to be sorted
+// externally. footprint() is the in-memory size of an element, used to respect the memory budget.
+template <typename T, typename Enable = void>
+struct ExternalRecordCodec;
+
+template <typename T>
+struct ExternalRecordCodec<T, typename std::enable_if<std::is_trivially_copyable<T>::value>::type> {
+    static void write(RunWriter& writer, const T& element) { writer.writeBytes(&element, sizeof(T)); }
+    static bool read(RunReader& reader, T& element) { return reader.readBytes(&element, sizeof(T)); }
+    static size_t footprint(const T&) { return sizeof(T); }
+};
+
+template <>
+struct ExternalRecordCodec<std::string> {
+    static void write(RunWriter& writer, const std::string& element) {
+        writer.writeVarint(element.size());
+        writer.writeBytes(element.data(), element.size());
+    }
+    static bool read(RunReader& reader, std::string& element) {
+        uint64_t length;
+        if (!reader.readVarint(length)) {
+            return false;
+        }
+        element.resize(length);
+        return reader.readBytes(&element[0], length);
+    }
+    static size_t footprint(const std::string& element) { return sizeof(std::string) + element.capacity(); }
+};
+
+// Borrow records are stored as two length-prefixed strings and two day numbers packed into varints.
+template <>
+struct ExternalRecordCodec<BorrowRecord> {
+    static void write(RunWriter& writer, const BorrowRecord& record) {
+        ExternalRecordCodec<std::string>::write(writer, record.patronId);
+        ExternalRecordCodec<std::string>::write(writer, record.bookISBN);
+        writer.writeVarint(packDate(record.checkoutDate));
+        writer.writeVarint(packDate(record.returnDate));
+    }
+    static bool read(RunReader& reader, BorrowRecord& record) {
+        uint64_t checkout;
+        uint64_t returned;
+        if (!ExternalRecordCodec<std::string>::read(reader, record.patronId) ||
+            !ExternalRecordCodec<std::string>::read(reader, record.bookISBN) ||
+            !reader.readVarint(checkout) || !reader.readVarint(returned)) {
+            return false;
+        }
+        record.checkoutDate = unpackDate(checkout);
+        record.returnDate = unpackDate(returned);
+        return true;
+    }
+    static size_t footprint(const BorrowRecord& record) {
+        return sizeof(BorrowRecord) + record.patronId.capacity() + record.bookISBN.capacity();
+    }
+
+private:
+    // Day numbers are zigzag encoded so that dates before 1970 stay short as well
+    static uint64_t packDate(const Date& date) {
+        int64_t days = date.getDayNumber();
+        return (static_cast<uint64_t>(days) << 1) ^ static_cast<uint64_t>(days >> 63);
+    }
+    static Date unpackDate(uint64_t packed) {
+        return Date::fromDayNumber(static_cast<DayNumber>(static_cast<int64_t>(packed >> 1) ^
+                                                          -static_cast<int64_t>(packed & 1)));
+    }
+};
+
+template <typename T>
+class ExternalMergeSort {
+public:
+    // memoryBudget is the number of bytes the buffered elements and the merge I/O buffers may take up
+    ExternalMergeSort(std::function<bool(const T&, const T&)> compareFunc, size_t memoryBudget)
+            : compare(compareFunc), memoryBudget(memoryBudget), bufferedBytes(0), peakBytes(0), outputBytes(0) {}
+    ~ExternalMergeSort();
+    ExternalMergeSort(const ExternalMergeSort&) = delete;
+    ExternalMergeSort& operator=(const ExternalMergeSort&) = delete;
+
+    // Adds an element to the sort, spilling a sorted run to a temporary file once the memory budget is exceeded
+    void add(const T& element);
+    // Merges everything added so far and streams it out in sorted order
+    void sort(const std::function<void(const T&)>& output);
+    // Merges everything added so far into a file, using the same binary encoding as the runs
+    void sortToFile(const std::string& path);
+    // Streams the elements of a file written by sortToFile
+    static void readFile(const std::string& path, const std::function<void(const T&)>& output);
+    // Number of runs spilled to disk so far
+    size_t runCount() const { return runs.size(); }
+    // Most bytes the sort has held against its memory budget at once: the buffered elements and their array, the
+    // buffer of a run being spilled, and the I/O buffers, current heads and loser tree of a merge
+    size_t peakMemory() const { return peakBytes; }
+
+private:
+    // Smallest per-run read buffer a merge is allowed to use, which bounds the merge fan-in
+    static constexpr size_t MIN_IO_BUFFER = 4096;
+
+    std::function<bool(const T&, const T&)> compare;
+    size_t memoryBudget;
+    size_t bufferedBytes;
+    size_t peakBytes;
+    // Buffer of the writer sortToFile keeps open around the merge
+    size_t outputBytes;
+    std::vector<T> buffer;
+    std::vector<std::FILE*> runs;
+
+    // Part of the budget kept for the writer of a spilled run, the buffered elements get the rest
+    size_t spillBufferSize() const;
+    // Bytes the buffered elements take up, with room for the whole array and for the scratch space of the run sort
+    size_t residentBytes() const { return bufferedBytes + buffer.capacity() * sizeof(T); }
+    void recordUsage(size_t bytes) { peakBytes = std::max(peakBytes, bytes + outputBytes); }
+    // Makes room for one more element, spilling first if growing the array would exceed the budget
+    void growBuffer();
+    void spillRun();
+    size_t ioBufferSize(size_t streams) const;
+    // k-way merge of the given runs using a loser tree; every file is closed once consumed
+    void mergeRuns(const std::vector<std::FILE*>& inputs, const std::function<void(const T&)>& output);
+};
+
+#include "../src/ExternalMergeSort.cpp"
+
+#endif //EXTERNALMERGESORT_H
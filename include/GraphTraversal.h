@@ -0,0 +1,47 @@
+#ifndef GRAPHTRAVERSAL_H
+#define GRAPHTRAVERSAL_H
+/**
+ * Implementation of iterative depth first and breadth first traversals over a CSR graph.
+ */
+#include <vector>
+#include <cstdint>
+#include "CsrGraph.h"
+#include "DenseBitset.h"
+#include "Stack.h"
+
+// Walks the CSR arrays of a graph without recursion, so the traversal depth is bounded by memory rather than by the
+// thread stack. Visited vertices are marked in a dense bitset that persists across calls, so a loop over every
+// start vertex finds each component once.
+class GraphTraversal {
+public:
+    // The arrays must outlive the traversal: the neighbours of v are targets[offsets[v]] up to targets[offsets[v + 1]]
+    GraphTraversal(const uint64_t* offsets, const uint32_t* targets, uint32_t vertexCount);
+    // The graph must outlive the traversal as well
+    explicit GraphTraversal(const CsrGraph& graph);
+
+    // Appends every unvisited vertex reachable from start to reached, in the preorder of a recursive depth first
+    // search. Nothing is appended if start was already visited.
+    void depthFirst(uint32_t start, std::vector<uint32_t>& reached);
+    // Same vertices as depthFirst, in breadth first order; the new part of reached doubles as the queue
+    void breadthFirst(uint32_t start, std::vector<uint32_t>& reached);
+    bool visited(uint32_t vertex) const { return visited_.test(vertex); }
+    // Forgets every visit
+    void reset() { visited_.clear(); }
+
+private:
+    // A vertex whose neighbours are scanned up to, but not including, nextEdge
+    struct Frame {
+        uint32_t vertex;
+        uint64_t nextEdge;
+    };
+
+    const uint64_t* offsets_;
+    const uint32_t* targets_;
+    DenseBitset visited_;
+    // Kept between calls so that its buffer is allocated once
+    Stack<Frame> frames_;
+};
+
+#include "../src/GraphTraversal.cpp"
+
+#endif //GRAPHTRAVERSAL_H
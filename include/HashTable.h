@@ -76,6 +76,8 @@ public:
 
 private:
     unsigned int hopRange = HOP_RANGE;
+    // Number of occupied buckets, kept up to date so that size() does not scan the table on every insert
+    unsigned int occupiedCount = 0;
     // TODO implement the following functions in ../src/HashTable.cpp
     unsigned int findFreeSlot(std::vector<Bucket>& cTable, unsigned int startIndex, unsigned int& currentHop);
     void rehash();
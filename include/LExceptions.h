@@ -21,6 +21,13 @@ public:
     }
 };
 
+class LibraryReservationQueueClosed : public std::exception {
+public:
+    const char * what () {
+        return "Library is no longer receiving reservation requests!";
+    }
+};
+
 class UnavailableBookToBorrow : public std::exception {
 private:
     Book book;
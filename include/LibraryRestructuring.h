@@ -9,35 +9,106 @@
  */
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <memory>
+#include <string_view>
 #include "Utils.h"
 #include "UnorderedSet.h"
 #include "HashTable.h"
 #include "RadixSort.h"
 #include "MergeSort.h"
+#include "StringRadixSort.h"
+#include "StringInterner.h"
+#include "BookCatalog.h"
+#include "CsrGraph.h"
+#include "DisjointSet.h"
+#include "Stack.h"
+#include "DenseBitset.h"
+#include "GraphTraversal.h"
+#include "ParallelComponents.h"
+#include "BorrowRecordTable.h"
+#include "LibrarySnapshot.h"
 
 class LibraryRestructuring {
 public:
-    // TODO implement the following functions in ../src/LibraryRestructuring.cpp
+    // How the table constructors find the clusters; every mode yields the same clusterAndSort result
+    enum class ClusteringMode {
+        // Iterative depth first search over the CSR co-borrow graph
+        GRAPH,
+        // Union-find over book ids, fed one record at a time: each patron's books are united with the first book the
+        // patron borrowed. No edges are kept, so getGraph() stays empty and saveSnapshot throws std::logic_error.
+        UNION_FIND,
+        // Components of the patron-book incidence, which is linear in the record count where the co-borrow graph
+        // grows with the square of every patron's loans. getGraph() expands it into co-borrow edges on demand, and
+        // saveSnapshot throws std::logic_error.
+        BIPARTITE
+    };
+
     explicit LibraryRestructuring(const UnorderedSet<BorrowRecord>& records, const UnorderedSet<Book>& bookCollection);
-    // Get the graph of books
-    HashTable<std::string, UnorderedSet<std::string>>& getGraph() {return graph;}
+    // Builds the same structures from a columnar table: the co-borrow graph is built over the table's book ids as a
+    // CsrGraph, where every patron links each pair of distinct books they borrowed
+    explicit LibraryRestructuring(const BorrowRecordTable& records, const UnorderedSet<Book>& bookCollection,
+                                  ClusteringMode mode = ClusteringMode::GRAPH);
+    // Same as above with the books already in a catalog, which is moved in rather than copied book by book
+    explicit LibraryRestructuring(const BorrowRecordTable& records, BookCatalog bookCatalog,
+                                  ClusteringMode mode = ClusteringMode::GRAPH);
+    // Get the graph of books. Clustering runs on the CSR adjacency, so this string keyed copy is only built on the
+    // first call
+    HashTable<std::string, UnorderedSet<std::string>>& getGraph();
     // Cluster the graph nodes and sort clusters by average borrowing time, within each cluster, the nodes must be
     // internally sorted based on "sortBy" type which can be one of "title", "author", and "yearPublished"
     // HINT: You need to use both RadixSort and MergeSort implementations for the implementation of clusterAndSort
     std::vector<std::vector<std::string>> clusterAndSort(const std::string& sortBy);
+    // Threads used to find the clusters of the co-borrow graph in GRAPH mode: 1 (the default) runs the depth first
+    // search, anything else runs ParallelComponents, 0 on every hardware thread. Both find the same clusters.
+    void setClusterThreads(unsigned int threadCount);
+    // Saves the catalog, the borrowing times and the graph to a snapshot file, throws std::runtime_error on failure
+    void saveSnapshot(const std::string& path);
+    // Maps a snapshot written by saveSnapshot. Nothing is rebuilt: clusterAndSort reads the mapped arrays in place.
+    // See LibrarySnapshot for what verify checks.
+    static LibraryRestructuring fromSnapshot(const std::string& path, bool verify = true);
 
 private:
-    // Stores the graph representation using an adjacency list
+    // Stores the graph representation using an adjacency list, filled from adjacency by getGraph()
     HashTable<std::string, UnorderedSet<std::string>> graph;
-    // Stores the sum of borrowing time for each book
-    HashTable<std::string, int> bookBorrowingTime;
     // Stores all the available books in the library, created when the constructor is called
-    HashTable<std::string, Book> allBooks;
-    // TODO implement the following functions in ../src/LibraryRestructuring.cpp
-    // perform a DFS search to find all the nodes connected to the pointed current ISBN
-    void dfs(const std::string& current, std::vector<std::string>& cluster, HashTable<std::string, bool>& visited);
+    BookCatalog catalog;
+    // Dense ids for the ISBNs in the graph; clustering and sorting run on these and only the result holds strings
+    StringInterner bookIds;
+    // Number of ids that are keys of graph, searches start from these in id order
+    uint32_t rootCount;
+    ClusteringMode mode;
+    unsigned int clusterThreads;
+    // Neighbours of every book by id, in GRAPH mode
+    CsrGraph adjacency;
+    // Connected books by id, in UNION_FIND mode
+    DisjointSet components;
+    // Distinct books of every patron id and patrons of every book id, in BIPARTITE mode
+    CsrGraph booksOfPatron;
+    CsrGraph patronsOfBook;
+    // Sum of borrowing time of every book, indexed by id
+    std::vector<int64_t> borrowingTimeById;
+    // Catalog entry of every book, indexed by id, BookCatalog::NOT_FOUND for books missing from the catalog
+    std::vector<BookRef> catalogRefById;
+    // Set when loaded from a snapshot, whose mapped arrays then stand in for the id-indexed members above
+    std::shared_ptr<const LibrarySnapshot> snapshot;
+
+    LibraryRestructuring() : rootCount(0), mode(ClusteringMode::GRAPH), clusterThreads(1) {}
+    // Id-indexed state, read from the snapshot when there is one
+    uint32_t nodes() const;
+    uint32_t roots() const;
+    const uint64_t* edgeOffsets() const;
+    const uint32_t* edgeTargets() const;
+    int64_t borrowingTimeOf(uint32_t book) const;
+    std::string_view isbnOf(uint32_t book) const;
+    // Title (or author) of every id, "" for books missing from the catalog
+    void shelfKeys(bool byTitle, std::vector<std::string_view>& keys) const;
+    // Year published of every id, BookCatalog::UNKNOWN_YEAR for books missing from the catalog
+    void shelfYears(std::vector<int>& years) const;
+    // Clusters of more than one book, ordered by their smallest id, each holding its books in ascending id order
+    std::vector<std::vector<uint32_t>> findClusters();
     // calculate the average number of days that the books in this cluster has been borrowed
-    double getAverageBorrowingTime(const std::vector<std::string>& cluster);
+    double getAverageBorrowingTime(const std::vector<uint32_t>& cluster);
 };
 
 
@@ -0,0 +1,125 @@
+#ifndef LIBRARYSNAPSHOT_H
+#define LIBRARYSNAPSHOT_H
+/**
+ * Implementation of a versioned, checksummed binary snapshot of the catalog and restructuring state.
+ */
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstdio>
+#include "MappedFile.h"
+
+// A catalog book whose text fields are ids into the snapshot's string pool
+struct SnapshotBook {
+    uint32_t isbn;
+    uint32_t title;
+    uint32_t author;
+    uint32_t publisher;
+    uint32_t yearPublished;
+    int32_t copies;
+};
+
+// Fixed-size header at the start of the file. Every section starts at an 8-byte aligned offset, is padded to a
+// multiple of 8 bytes and is laid out in host byte order, so a mapped section is used in place as an array.
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    // Written as 0x01020304, a file from a host with another byte order reads back differently
+    uint32_t byteOrder;
+    // Checksum of every byte after the header
+    uint64_t checksum;
+    uint64_t fileSize;
+    // String pool: stringCount + 1 offsets into stringByteCount bytes of text
+    uint64_t stringCount;
+    uint64_t stringByteCount;
+    uint64_t stringOffsetsAt;
+    uint64_t stringBytesAt;
+    // Catalog books
+    uint64_t bookCount;
+    uint64_t booksAt;
+    // Graph nodes: ISBN string id, index into the books (or NO_BOOK) and borrowing time sum; searches start from the
+    // first rootCount nodes
+    uint64_t nodeCount;
+    uint64_t rootCount;
+    uint64_t nodeIsbnsAt;
+    uint64_t nodeBooksAt;
+    uint64_t borrowingTimesAt;
+    // CSR adjacency: nodeCount + 1 offsets into edgeCount neighbour ids
+    uint64_t edgeCount;
+    uint64_t edgeOffsetsAt;
+    uint64_t edgeTargetsAt;
+};
+
+// Read side of the snapshot. Opening one maps the file and points straight into it; with verification on, the
+// checksum and every id and offset are checked once so that later accessors never read out of bounds.
+class LibrarySnapshot {
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t NO_BOOK = UINT32_MAX;
+
+    // Everything a snapshot holds, as arrays in memory, for write
+    struct Contents {
+        std::vector<std::string_view> strings;
+        std::vector<SnapshotBook> books;
+        uint32_t rootCount = 0;
+        std::vector<uint32_t> nodeIsbns;
+        std::vector<uint32_t> nodeBooks;
+        std::vector<int64_t> borrowingTimes;
+        std::vector<uint64_t> edgeOffsets;
+        std::vector<uint32_t> edgeTargets;
+    };
+
+    // Throws std::runtime_error for a file that is not a snapshot of this version and byte order, or, when verify is
+    // set, one that is truncated, corrupted or inconsistent. Skipping verification makes opening O(1) and is only
+    // safe for trusted files.
+    explicit LibrarySnapshot(const std::string& path, bool verify = true);
+    // Writes contents to path, throws std::runtime_error if it cannot be written
+    static void write(const std::string& path, const Contents& contents);
+
+    size_t stringCount() const { return header_->stringCount; }
+    std::string_view string(uint32_t id) const {
+        return std::string_view(stringBytes_ + stringOffsets_[id], stringOffsets_[id + 1] - stringOffsets_[id]);
+    }
+    size_t bookCount() const { return header_->bookCount; }
+    const SnapshotBook& book(size_t index) const { return books_[index]; }
+    uint32_t nodeCount() const { return static_cast<uint32_t>(header_->nodeCount); }
+    uint32_t rootCount() const { return static_cast<uint32_t>(header_->rootCount); }
+    uint32_t nodeIsbn(uint32_t node) const { return nodeIsbns_[node]; }
+    uint32_t nodeBook(uint32_t node) const { return nodeBooks_[node]; }
+    int64_t borrowingTime(uint32_t node) const { return borrowingTimes_[node]; }
+    size_t edgeCount() const { return header_->edgeCount; }
+    const uint64_t* edgeOffsets() const { return edgeOffsets_; }
+    const uint32_t* edgeTargets() const { return edgeTargets_; }
+
+private:
+    static constexpr char MAGIC[8] = {'L', 'I', 'B', 'S', 'N', 'A', 'P', '\0'};
+    static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+    static constexpr uint64_t CHECKSUM_SEED = 0x9E3779B97F4A7C15ull;
+
+    MappedFile file_;
+    const SnapshotHeader* header_;
+    const uint64_t* stringOffsets_;
+    const char* stringBytes_;
+    const SnapshotBook* books_;
+    const uint32_t* nodeIsbns_;
+    const uint32_t* nodeBooks_;
+    const int64_t* borrowingTimes_;
+    const uint64_t* edgeOffsets_;
+    const uint32_t* edgeTargets_;
+
+    // Folds whole 8-byte words into a running checksum
+    static uint64_t checksum(uint64_t state, const char* data, size_t size);
+    // Appends count elements to file, zero padded to 8 bytes, advancing offset and the checksum; returns where the
+    // section starts
+    template <typename T>
+    static uint64_t writeSection(FILE* file, const T* data, size_t count, uint64_t& offset, uint64_t& state);
+    // Pointer to count elements at offset, checked to lie inside the file
+    template <typename T>
+    const T* section(uint64_t offset, uint64_t count) const;
+    void verifyContents() const;
+};
+
+#include "../src/LibrarySnapshot.cpp"
+
+#endif //LIBRARYSNAPSHOT_H
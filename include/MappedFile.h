@@ -0,0 +1,30 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+/**
+ * Implementation of a read-only memory-mapped file.
+ */
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+// Read-only memory map of a whole file, unmapped when destroyed
+class MappedFile {
+public:
+    // Throws std::runtime_error if the file cannot be opened or mapped
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    std::string_view text() const { return std::string_view(data_, size_); }
+
+private:
+    const char* data_;
+    size_t size_;
+};
+
+#include "../src/MappedFile.cpp"
+
+#endif //MAPPEDFILE_H
@@ -16,10 +16,49 @@ public:
     explicit MergeSort(std::function<bool(const T&, const T&)> compareFunc) : compare(compareFunc) {}
     // TODO implement the following functions in ../src/MergeSort.cpp
     void sort(std::vector<T>& arr);
+    // Adaptive (natural run) stable sort: detects existing ascending and strictly descending runs, merges them under
+    // the TimSort stack invariants and gallops when one run keeps winning. Presorted input costs n - 1 comparisons.
+    void adaptiveSort(std::vector<T>& arr);
+    // Sorts elements by the key keyFunction extracts from them (of type T, ordered by this sort's comparator). Every
+    // key is extracted exactly once into a contiguous (key, index) array, which is sorted before the resulting
+    // permutation is applied to the elements with moves. Stable.
+    template <typename Element, typename KeyFunction>
+    void sortByKey(std::vector<Element>& elements, KeyFunction keyFunction);
 
 private:
+    // A pending natural run waiting on the merge stack
+    struct Run {
+        long base;
+        long length;
+    };
+
+    // A key extracted by sortByKey and the position of the element it was extracted from
+    struct KeyedIndex {
+        T key;
+        size_t index;
+    };
+
+    // Inputs shorter than this are binary insertion sorted in a single run
+    static constexpr long MIN_MERGE = 32;
+    // Consecutive wins by one run before a merge switches into galloping mode
+    static constexpr long MIN_GALLOP = 7;
+
     std::function<bool(const T&, const T&)> compare;
+    // Current galloping threshold, adapted while merging
+    long minGallop = MIN_GALLOP;
+    // Scratch space for the smaller of the two runs being merged
+    std::vector<T> mergeBuffer;
     void merge(std::vector<T>& arr, const std::vector<T>& left, const std::vector<T>& right);
+    long computeMinRun(long n) const;
+    long countRunAndMakeAscending(std::vector<T>& arr, long lo, long hi);
+    void binaryInsertionSort(std::vector<T>& arr, long lo, long hi, long start);
+    long gallopLeft(const T& key, const T* run, long length, long hint);
+    long gallopRight(const T& key, const T* run, long length, long hint);
+    void mergeCollapse(std::vector<T>& arr, std::vector<Run>& runs);
+    void mergeForceCollapse(std::vector<T>& arr, std::vector<Run>& runs);
+    void mergeAt(std::vector<T>& arr, std::vector<Run>& runs, long i);
+    void mergeLow(std::vector<T>& arr, long base1, long len1, long base2, long len2);
+    void mergeHigh(std::vector<T>& arr, long base1, long len1, long base2, long len2);
 };
 
 #include "../src/MergeSort.cpp"
@@ -0,0 +1,54 @@
+#ifndef PARALLELCOMPONENTS_H
+#define PARALLELCOMPONENTS_H
+/**
+ * Implementation of multithreaded connected components over a CSR graph (Afforest).
+ */
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include "CsrGraph.h"
+
+// Every vertex starts as its own tree and threads hook trees together with a compare-and-swap, always pointing the
+// higher root at the lower one, so a tree's root is its smallest vertex. The first SAMPLED_EDGES edges of every vertex
+// are linked first; that usually joins most of the graph into one component, whose vertices then skip the rest of
+// their edges. The graph must be undirected, with every edge stored in both directions.
+class ParallelComponents {
+public:
+    // Edges of every vertex linked before the largest component is sampled
+    static constexpr uint32_t SAMPLED_EDGES = 2;
+    // Vertices looked at to guess the largest component
+    static constexpr uint32_t SAMPLE_SIZE = 1024;
+    // Vertices a thread claims at a time, small enough to balance skewed degrees
+    static constexpr uint32_t CHUNK_SIZE = 4096;
+
+    // The arrays must outlive the engine: the neighbours of v are targets[offsets[v]] up to targets[offsets[v + 1]].
+    // A threadCount of 0 uses every hardware thread.
+    ParallelComponents(const uint64_t* offsets, const uint32_t* targets, uint32_t vertexCount,
+                       unsigned int threadCount = 0);
+    // The graph must outlive the engine as well
+    explicit ParallelComponents(const CsrGraph& graph, unsigned int threadCount = 0);
+
+    // Label of every vertex: the smallest vertex of its component, whatever the thread count
+    std::vector<uint32_t> labels() const;
+    unsigned int threadCount() const { return threadCount_; }
+
+private:
+    const uint64_t* offsets_;
+    const uint32_t* targets_;
+    uint32_t vertexCount_;
+    unsigned int threadCount_;
+
+    // Runs body(v) for every vertex, threads claiming CHUNK_SIZE vertices at a time
+    template <typename Body>
+    void forEachVertex(Body body) const;
+    // Root of the tree holding vertex, halving the path to it
+    static uint32_t find(std::atomic<uint32_t>* parent, uint32_t vertex);
+    // Joins the trees of a and b
+    static void link(std::atomic<uint32_t>* parent, uint32_t a, uint32_t b);
+    // Most frequent root among SAMPLE_SIZE pseudo-random vertices
+    uint32_t sampleLargest(const std::atomic<uint32_t>* parent) const;
+};
+
+#include "../src/ParallelComponents.cpp"
+
+#endif //PARALLELCOMPONENTS_H
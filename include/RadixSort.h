@@ -12,20 +12,94 @@
 #include <functional>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <thread>
 
-template <typename T>
+// Order in which lsdSort arranges the keys
+enum class SortOrder { ASCENDING, DESCENDING };
+
+// Maps a key onto an unsigned integer (Bits) that orders the same way, so that it can be sorted digit by digit.
+template <typename Key, typename Enable = void>
+struct RadixKeyTraits;
+
+// Signed integers have their sign bit flipped so that negative keys come before positive ones.
+template <typename Key>
+struct RadixKeyTraits<Key, typename std::enable_if<std::is_integral<Key>::value>::type> {
+    using Bits = typename std::make_unsigned<Key>::type;
+    static Bits toBits(Key key) {
+        Bits bits = static_cast<Bits>(key);
+        return std::is_signed<Key>::value ? bits ^ (Bits(1) << (sizeof(Bits) * 8 - 1)) : bits;
+    }
+};
+
+// IEEE-754 floating point: positive keys get their sign bit set, negative keys have all their bits flipped.
+template <typename Key>
+struct RadixKeyTraits<Key, typename std::enable_if<std::is_floating_point<Key>::value>::type> {
+    using Bits = typename std::conditional<sizeof(Key) == 4, uint32_t, uint64_t>::type;
+    static_assert(sizeof(Key) == sizeof(Bits), "Only float and double keys are supported.");
+    static Bits toBits(Key key) {
+        Bits bits;
+        std::memcpy(&bits, &key, sizeof(Bits));
+        const Bits signBit = Bits(1) << (sizeof(Bits) * 8 - 1);
+        return (bits & signBit) ? ~bits : bits | signBit;
+    }
+};
+
+template <typename T, typename Key = int>
 class RadixSort {
 public:
-    RadixSort(std::vector<T>& elements, std::function<int(const T&)> getKeyFunction)
+    RadixSort(std::vector<T>& elements, std::function<Key(const T&)> getKeyFunction)
             : elements_(elements), getKeyFunction_(getKeyFunction) {}
 
     // TODO implement the following functions in ../src/RadixSort.cpp
     // Inline sorting method
     void sort();
+    // Inline LSD sort on digitBits-wide (8, 11 or 16 bit) digits. Keys are evaluated once, all digit histograms are
+    // built in a single pass over them, passes in which every key has the same digit are skipped, and elements
+    // ping-pong between two buffers instead of being copied back after every pass. Any integral, float or double key
+    // type is supported. Stable in both orders.
+    void lsdSort(int digitBits = 8, SortOrder order = SortOrder::ASCENDING);
+    // Same ordering as lsdSort for heavy element types: each key is evaluated once into a packed (key, index) array,
+    // only that array is radix sorted, and the elements are moved into their final positions once at the end.
+    void indexSort(int digitBits = 8, SortOrder order = SortOrder::ASCENDING);
+    // Multithreaded indexSort. Every pass, each thread counts the digits of its own chunk, a global prefix sum gives
+    // every (thread, digit) pair its own output range, and threads scatter into it without locks through small
+    // per-digit write-combining buffers. The key function is called concurrently, so it must be thread safe. A
+    // threadCount of 0 uses every hardware thread. Stable.
+    void parallelSort(unsigned int threadCount = 0, int digitBits = 8, SortOrder order = SortOrder::ASCENDING);
+    // Places the k first elements of the given order at the front, exactly sorted. An MSD histogram of the top byte
+    // finds the bucket holding the k-th key, every key in a bucket before it is taken, and only that bucket is
+    // narrowed down on the next byte. The remaining elements follow in their original relative order. Stable.
+    void partialSort(size_t k, SortOrder order = SortOrder::ASCENDING);
 
 private:
+    using Bits = typename RadixKeyTraits<Key>::Bits;
+
+    // A mapped key and the position of the element it was extracted from
+    struct KeyedIndex {
+        Bits key;
+        uint32_t index;
+    };
+
+    // Bytes a thread gathers per digit before writing them out together, one cache line
+    static constexpr size_t WRITE_COMBINE_BYTES = 64;
+
     std::vector<T>& elements_;
-    std::function<int(const T&)> getKeyFunction_;
+    std::function<Key(const T&)> getKeyFunction_;
+    // Stable LSD sort of packed keys on digitBits-wide digits
+    static void sortKeyed(std::vector<KeyedIndex>& keyed, int digitBits);
+    // Adds the digits of every pass of key to histograms
+    static void countDigits(Bits key, size_t* histograms, int digitBits);
+    // The LSD passes shared by lsdSort, indexSort and sortKeyed over n records, given the digit histograms of every
+    // pass. keyAt(i) is the key of the i-th record in the current order, scatter(i, position) moves that record to
+    // position in the other buffer and flip() makes the other buffer the current one. Passes in which every key has
+    // the same digit are skipped.
+    template <typename KeyAt, typename Scatter, typename Flip>
+    static void runPasses(size_t n, int digitBits, std::vector<size_t>& histograms, KeyAt keyAt, Scatter scatter,
+                          Flip flip);
     // TODO implement the following functions in ../src/RadixSort.cpp
     int getMaxDigitCount();
     int getDigitCount(int number);
@@ -0,0 +1,89 @@
+#ifndef RESERVATIONQUEUE_H
+#define RESERVATIONQUEUE_H
+/**
+ * Implementation of a bounded lock-free multi-producer/multi-consumer reservation queue.
+ */
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <condition_variable>
+#include "LExceptions.h"
+
+// Ring buffer in which every cell carries a sequence number telling producers and consumers whose turn it is
+// (D. Vyukov's bounded MPMC queue). A producer claims a slot with one compare-and-swap on the tail and a consumer
+// with one on the head, so threads only contend on those two counters and never take a lock. The blocking push and
+// pop spin briefly and then park on a condition variable; the lock-free calls only touch the mutex to wake a parked
+// thread, which they learn about from a waiter count.
+template <typename T>
+class ReservationQueue {
+public:
+    // The capacity is rounded up to a power of two
+    explicit ReservationQueue(size_t capacity);
+
+    // Adds a reservation without waiting, returns false when the queue is full
+    bool tryPush(const T& reservation);
+    // Takes the oldest reservation without waiting, returns false when the queue is empty
+    bool tryPop(T& reservation);
+    // Waits for room, returns false if the queue was closed before the reservation could be added
+    bool push(const T& reservation);
+    // Waits for a reservation, returns false once the queue is closed and every accepted reservation was popped
+    bool pop(T& reservation);
+    // Wakes every blocked call, pushes fail from now on and pops fail once the queue is drained
+    void close();
+
+    // Same as tryPush/tryPop but throw LibraryReservationQueueFull (LibraryReservationQueueClosed once the queue is
+    // closed) or ReservationRecordUnavailable
+    void pushOrThrow(const T& reservation);
+    T popOrThrow();
+
+    size_t capacity() const { return mask_ + 1; }
+    bool isClosed() const { return (tail_.load(std::memory_order_seq_cst) & CLOSED_BIT) != 0; }
+
+private:
+    static constexpr size_t CACHE_LINE_BYTES = 64;
+    // Set in the tail by close(), so that no producer can claim a cell once the queue is closed
+    static constexpr size_t CLOSED_BIT = ~(std::numeric_limits<size_t>::max() >> 1);
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T reservation;
+    };
+
+    std::vector<Cell> cells_;
+    size_t mask_;
+    // The counters sit on their own cache lines so that producers and consumers do not invalidate each other
+    alignas(CACHE_LINE_BYTES) std::atomic<size_t> tail_;
+    alignas(CACHE_LINE_BYTES) std::atomic<size_t> head_;
+
+    // Blocked push and pop calls park here once spinning has not helped. The counts let the lock-free calls skip the
+    // mutex while nobody is parked.
+    alignas(CACHE_LINE_BYTES) std::atomic<unsigned int> pushWaiters_;
+    std::atomic<unsigned int> popWaiters_;
+    std::mutex mutex_;
+    std::condition_variable notFull_;
+    std::condition_variable notEmpty_;
+
+    // Failed attempts a blocking call makes back to back, then after giving the core away, before it parks
+    static constexpr unsigned int SPIN_ROUNDS = 64;
+    static constexpr unsigned int YIELD_ROUNDS = 64;
+
+    // Pause after the given failed attempt of a blocking call
+    static void backoff(unsigned int round);
+
+    // The lock-free claim of a cell behind tryPush and tryPop, which also wake parked threads on success
+    bool pushCell(const T& reservation);
+    bool popCell(T& reservation);
+    // Whether the queue is closed and every claimed cell has been popped
+    bool drained() const;
+    // Wakes one (or every) thread parked on condition, if waiters says there is any
+    void wake(const std::atomic<unsigned int>& waiters, std::condition_variable& condition, bool all);
+    // Wakes the threads a successful push or pop may have unblocked
+    void pushed();
+    void popped();
+};
+
+#include "../src/ReservationQueue.cpp"
+
+#endif //RESERVATIONQUEUE_H
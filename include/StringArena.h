@@ -0,0 +1,41 @@
+#ifndef STRINGARENA_H
+#define STRINGARENA_H
+/**
+ * Implementation of an append-only arena for string data.
+ */
+#include <vector>
+#include <string_view>
+#include <memory>
+#include <cstddef>
+
+// Copies strings into large chunks that are never moved or freed before the arena, so the views it hands out stay
+// valid for the arena's lifetime, including across moves of the arena itself. Strings are packed back to back, which
+// replaces one heap allocation per string with one per chunk.
+class StringArena {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    explicit StringArena(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+    StringArena(StringArena&& other) noexcept;
+    StringArena& operator=(StringArena&& other) noexcept;
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    // Copies value into the arena and returns a view of the copy
+    std::string_view store(std::string_view value);
+    // Bytes of string data stored
+    size_t bytes() const { return bytes_; }
+    size_t chunkCount() const { return chunks_.size(); }
+
+private:
+    size_t chunkSize_;
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    // Free space at the end of the chunk being filled
+    char* next_;
+    size_t remaining_;
+    size_t bytes_;
+};
+
+#include "../src/StringArena.cpp"
+
+#endif //STRINGARENA_H
@@ -0,0 +1,52 @@
+#ifndef STRINGINTERNER_H
+#define STRINGINTERNER_H
+/**
+ * Implementation of a string interner handing out dense integer ids.
+ */
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <limits>
+
+// Maps every distinct string to an id in 0..size()-1, given out in the order the strings were first seen, and back.
+// The table is open addressed; every slot packs an id with the top half of its string's hash, so a lookup hashes the
+// key once and compares characters only against a string whose slot tag matches.
+class StringInterner {
+public:
+    static constexpr uint32_t NOT_FOUND = std::numeric_limits<uint32_t>::max();
+
+    explicit StringInterner(size_t expectedSize = 16);
+
+    // Id of the string, adding it if it has not been seen before
+    uint32_t intern(std::string_view value);
+    // Same as intern with hashValue == hash(value) computed beforehand, e.g. on another thread
+    uint32_t intern(std::string_view value, uint64_t hashValue);
+    // Id of the string, or NOT_FOUND
+    uint32_t lookup(std::string_view value) const;
+    // The string behind an id
+    const std::string& resolve(uint32_t id) const { return strings_[id]; }
+    size_t size() const { return strings_.size(); }
+    void reserve(size_t expectedSize);
+    static uint64_t hash(std::string_view value);
+
+private:
+    // Strings by id
+    std::vector<std::string> strings_;
+    // Hash of every string by id, so growing the table never rehashes characters
+    std::vector<uint64_t> hashes_;
+    // Open addressed slots holding the hash's top 32 bits above id + 1, 0 marks an empty slot; the size is a power
+    // of two
+    std::vector<uint64_t> slots_;
+
+    static uint64_t slotEntry(uint64_t hashValue, uint32_t id) {
+        return (hashValue & ~uint64_t(0xFFFFFFFF)) | (id + 1);
+    }
+    // Slot holding the string, or the empty slot where it belongs
+    size_t findSlot(std::string_view value, uint64_t hashValue) const;
+    void grow(size_t slotCount);
+};
+
+#include "../src/StringInterner.cpp"
+
+#endif //STRINGINTERNER_H
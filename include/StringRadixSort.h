@@ -0,0 +1,50 @@
+#ifndef STRINGRADIXSORT_H
+#define STRINGRADIXSORT_H
+/**
+ * Implementation of an in-place MSD (American flag) radix sort for string keys.
+ */
+#include <vector>
+#include <string>
+#include <string_view>
+#include <functional>
+
+template <typename T, typename Key = std::string>
+class StringRadixSort {
+public:
+    // Key may be std::string or std::string_view; views must stay valid until sort() returns
+    StringRadixSort(std::vector<T>& elements, std::function<Key(const T&)> getKeyFunction)
+            : elements_(elements), getKeyFunction_(getKeyFunction) {}
+
+    // Inline, stable sorting method. Keys are extracted once, then partitioned byte by byte from the most significant
+    // end, so shared prefixes are scanned once per level instead of once per comparison.
+    void sort();
+
+private:
+    // A view of an element's key and the position of the element
+    struct KeyedIndex {
+        std::string_view key;
+        size_t index;
+    };
+
+    // Buckets smaller than this are sorted with multikey quicksort instead of a 257-way partition
+    static constexpr size_t QUICKSORT_THRESHOLD = 256;
+    // Buckets smaller than this are insertion sorted
+    static constexpr size_t INSERTION_THRESHOLD = 16;
+
+    std::vector<T>& elements_;
+    std::function<Key(const T&)> getKeyFunction_;
+
+    // Byte of the key at depth shifted up by one, 0 once the key has ended
+    static int digitAt(const KeyedIndex& entry, size_t depth);
+    // Orders keys on their bytes from depth onwards, equal keys by their original position
+    static bool lessFrom(const KeyedIndex& a, const KeyedIndex& b, size_t depth);
+    void americanFlagSort(std::vector<KeyedIndex>& keyed, size_t lo, size_t hi, size_t depth);
+    void multikeyQuicksort(std::vector<KeyedIndex>& keyed, size_t lo, size_t hi, size_t depth);
+    void insertionSort(std::vector<KeyedIndex>& keyed, size_t lo, size_t hi, size_t depth);
+    // Restores the original order of a range of equal keys
+    void sortByIndex(std::vector<KeyedIndex>& keyed, size_t lo, size_t hi);
+};
+
+#include "../src/StringRadixSort.cpp"
+
+#endif //STRINGRADIXSORT_H
@@ -0,0 +1,44 @@
+#ifndef TOPK_H
+#define TOPK_H
+/**
+ * Implementation of a streaming top-k selection over a bounded heap.
+ */
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include "RadixSort.h"
+
+template <typename T, typename Key = int>
+class TopK {
+public:
+    // Keeps the k first elements of the given order (the k largest keys for DESCENDING) out of everything pushed
+    TopK(size_t k, std::function<Key(const T&)> getKeyFunction, SortOrder order = SortOrder::DESCENDING)
+            : k_(k), getKeyFunction_(getKeyFunction), order_(order), pushed_(0) {}
+
+    // Offers an element to the selection in O(log k), the key is evaluated once
+    void push(const T& element);
+    // Number of elements currently kept, at most k
+    size_t size() const { return heap_.size(); }
+    // The kept elements in order; equal keys keep the order in which they were pushed
+    std::vector<T> result() const;
+
+private:
+    struct Entry {
+        Key key;
+        uint64_t sequence;
+        T element;
+    };
+
+    size_t k_;
+    std::function<Key(const T&)> getKeyFunction_;
+    SortOrder order_;
+    uint64_t pushed_;
+    // Heap with the entry that would be dropped first at its root
+    std::vector<Entry> heap_;
+    // Whether a belongs before b in the result
+    bool precedes(const Entry& a, const Entry& b) const;
+};
+
+#include "../src/TopK.cpp"
+
+#endif //TOPK_H
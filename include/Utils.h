@@ -9,10 +9,8 @@
  */
 #include <string>
 #include <sstream>
-// This is the only place that unordered_map is allowed to exist in the project solely because we need Utils.h to be
-// Independent of other components.
-#include <unordered_map>
 #include "Date.h"
+#include "AvailabilityCalendar.h"
 // IMPORT ID: 2
 // The classes in this file are already implemented and do not require any modification!
 class Book {
@@ -63,30 +61,44 @@ public:
     }
 
     void reduceCopiesOnDate(const Date& date) {
-        auto it = copiesOnDate.find(date);
-        if (it == copiesOnDate.end()) {
-            copiesOnDate[date] = copies;
-        }
+        reduceCopiesBetween(date, date);
+    }
 
-        if (copiesOnDate[date] <= 0) {
+    // Function to get the number of copies available on a specific date
+    int getCopiesOnDate(const Date& date) const {
+        return copies + checkedOut.changeOn(date);
+    }
+
+    // Whether a copy is available on every day from "from" to "to" (inclusive), in O(log D)
+    bool isAvailableBetween(const Date& from, const Date& to) const {
+        return copies + checkedOut.lowestChangeBetween(from, to) > 0;
+    }
+
+    // Takes one copy out on every day from "from" to "to" (inclusive) with a single O(log D) update
+    void reduceCopiesBetween(const Date& from, const Date& to) {
+        if (!tryReduceCopiesBetween(from, to)) {
             throw std::exception();
         }
-
-        copiesOnDate[date]--;
     }
 
-    // Function to get the number of copies available on a specific date
-    int getCopiesOnDate(const Date& date) const {
-        auto it = copiesOnDate.find(date);
-        if (it != copiesOnDate.end()) {
-            return it->second;
+    // Same as reduceCopiesBetween but reports an unavailable copy by returning false instead of throwing
+    bool tryReduceCopiesBetween(const Date& from, const Date& to) {
+        if (!isAvailableBetween(from, to)) {
+            return false;
         }
-        return copies;
+        checkedOut.add(from, to, -1);
+        return true;
+    }
+
+    // Puts one copy back on every day from "from" to "to" (inclusive)
+    void restoreCopiesBetween(const Date& from, const Date& to) {
+        checkedOut.add(from, to, 1);
     }
 
 private:
     Book::Hash internalHash;
-    std::unordered_map<Date, int, Date::Hash> copiesOnDate;
+    // Change in available copies per day, relative to "copies"
+    AvailabilityCalendar checkedOut;
 };
 
 
@@ -145,7 +157,7 @@ public:
 
     BorrowRecord(std::string& ID, std::string& ISBN, std::string& checkoutDate, std::string& returnDate): patronId(ID),
                                                                                                           bookISBN(ISBN), checkoutDate(Date::parseDate(checkoutDate)), returnDate(Date::parseDate(returnDate)) {}
-    BorrowRecord(): checkoutDate(Date::parseDate("1971-01-01")), returnDate(Date::parseDate("1971-01-01")) {};
+    BorrowRecord(): checkoutDate(1971, 1, 1), returnDate(1971, 1, 1) {};
 
     struct Hash {
         std::size_t operator()(const BorrowRecord& borrowRecord) const {
@@ -7,6 +7,19 @@
 #include "tests/MergeSortTests.h"
 #include "tests/RadixSortTests.h"
 #include "tests/LibraryRestructuringTests.h"
+#include "tests/DateTests.h"
+#include "tests/AvailabilityTests.h"
+#include "tests/CirculationTests.h"
+#include "tests/ReservationQueueTests.h"
+#include "tests/KeyEncodingTests.h"
+#include "tests/BorrowRecordTableTests.h"
+#include "tests/CsvLoaderTests.h"
+#include "tests/LibrarySnapshotTests.h"
+#include "tests/BookCatalogTests.h"
+#include "tests/CsrGraphTests.h"
+#include "tests/ClusteringTests.h"
+#include "tests/GraphTraversalTests.h"
+#include "tests/ParallelComponentsTests.h"
 #include "include/LExceptions.h"
 /*
  * This is the driver file which directs the project on testing different modules.
@@ -27,6 +40,32 @@ int main(int argc, char* argv[]) {
             radixSortTests();
             std::cout << ">> Library Restructuring System: \t";
             libraryRestructuringTests();
+            std::cout << ">> Date:\t\t\t\t\t\t\t";
+            dateTests();
+            std::cout << ">> Availability:\t\t\t\t\t";
+            availabilityTests();
+            std::cout << ">> Circulation:\t\t\t\t\t\t";
+            circulationTests();
+            std::cout << ">> Reservation Queue:\t\t\t\t";
+            reservationQueueTests();
+            std::cout << ">> Key Encoding:\t\t\t\t\t";
+            keyEncodingTests();
+            std::cout << ">> Borrow Record Table:\t\t\t\t";
+            borrowRecordTableTests();
+            std::cout << ">> CSV Loader:\t\t\t\t\t\t";
+            csvLoaderTests();
+            std::cout << ">> Library Snapshot:\t\t\t\t";
+            librarySnapshotTests();
+            std::cout << ">> Book Catalog:\t\t\t\t\t";
+            bookCatalogTests();
+            std::cout << ">> CSR Graph:\t\t\t\t\t\t";
+            csrGraphTests();
+            std::cout << ">> Clustering:\t\t\t\t\t\t";
+            clusteringTests();
+            std::cout << ">> Graph Traversal:\t\t\t\t\t";
+            graphTraversalTests();
+            std::cout << ">> Parallel Components:\t\t\t\t";
+            parallelComponentsTests();
             break;
         default:
             throw std::invalid_argument("Invalid module choice");
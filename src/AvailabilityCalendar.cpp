@@ -0,0 +1,124 @@
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include "../include/AvailabilityCalendar.h"
+
+// Each doubling makes the old root one child of a new root and an untouched node the other, so it costs two nodes
+// however far the window has to reach
+inline void AvailabilityCalendar::grow(int64_t lo, int64_t hi) {
+    if (size_ == 0) {
+        origin_ = lo;
+        size_ = 1;
+        tree.push_back(Node{0, 0, 0, 0});
+    }
+    while (lo < origin_ || hi > origin_ + size_) {
+        auto children = static_cast<uint32_t>(tree.size());
+        Node root = tree[0];
+        if (lo < origin_) {
+            tree.push_back(Node{0, 0, 0, 0});
+            tree.push_back(root);
+            origin_ -= size_;
+        } else {
+            tree.push_back(root);
+            tree.push_back(Node{0, 0, 0, 0});
+        }
+        size_ *= 2;
+        tree[0] = Node{0, std::min(root.lowest, 0), std::max(root.highest, 0), children};
+    }
+}
+
+inline void AvailabilityCalendar::shift(Node &node, int delta) {
+    node.add += delta;
+    node.lowest += delta;
+    node.highest += delta;
+}
+
+// The tree may reallocate when children are created, so nodes are only ever referred to by index
+inline void AvailabilityCalendar::update(uint32_t node, int64_t begin, int64_t size, int64_t lo, int64_t hi,
+                                         int delta) {
+    if (lo <= begin && begin + size <= hi) {
+        shift(tree[node], delta);
+        return;
+    }
+    if (tree[node].children == 0) {
+        // Both children start out equal to every day under the node, which is the node's own add
+        auto children = static_cast<uint32_t>(tree.size());
+        tree.push_back(Node{0, 0, 0, 0});
+        tree.push_back(Node{0, 0, 0, 0});
+        tree[node].children = children;
+    }
+    uint32_t left = tree[node].children;
+    int64_t half = size / 2;
+    if (lo < begin + half) {
+        update(left, begin, half, lo, hi, delta);
+    }
+    if (hi > begin + half) {
+        update(left + 1, begin + half, half, lo, hi, delta);
+    }
+    Node& parent = tree[node];
+    parent.lowest = parent.add + std::min(tree[left].lowest, tree[left + 1].lowest);
+    parent.highest = parent.add + std::max(tree[left].highest, tree[left + 1].highest);
+}
+
+// Every node's add applies to its whole subtree, so it is added to whatever its children report
+template <bool Highest>
+int AvailabilityCalendar::query(uint32_t node, int64_t begin, int64_t size, int64_t lo, int64_t hi) const {
+    const Node& current = tree[node];
+    if (lo <= begin && begin + size <= hi) {
+        return Highest ? current.highest : current.lowest;
+    }
+    if (current.children == 0) {
+        return current.add;
+    }
+    int64_t half = size / 2;
+    int result = Highest ? std::numeric_limits<int>::min() : std::numeric_limits<int>::max();
+    if (lo < begin + half) {
+        result = query<Highest>(current.children, begin, half, lo, hi);
+    }
+    if (hi > begin + half) {
+        int right = query<Highest>(current.children + 1, begin + half, half, lo, hi);
+        result = Highest ? std::max(result, right) : std::min(result, right);
+    }
+    return current.add + result;
+}
+
+inline void AvailabilityCalendar::add(const Date &from, const Date &to, int delta) {
+    int64_t lo = from.getDayNumber();
+    int64_t hi = static_cast<int64_t>(to.getDayNumber()) + 1;
+    if (hi <= lo) {
+        return;
+    }
+    grow(lo, hi);
+    update(0, origin_, size_, lo, hi, delta);
+}
+
+template <bool Highest>
+int AvailabilityCalendar::changeBetween(const Date &from, const Date &to) const {
+    int64_t lo = from.getDayNumber();
+    int64_t hi = static_cast<int64_t>(to.getDayNumber()) + 1;
+    if (hi <= lo) {
+        return 0;
+    }
+    // Days outside the window have never changed
+    if (size_ == 0 || hi <= origin_ || lo >= origin_ + size_) {
+        return 0;
+    }
+    int change = query<Highest>(0, origin_, size_, std::max(lo, origin_), std::min(hi, origin_ + size_));
+    if (lo < origin_ || hi > origin_ + size_) {
+        change = Highest ? std::max(change, 0) : std::min(change, 0);
+    }
+    return change;
+}
+
+inline int AvailabilityCalendar::changeOn(const Date &date) const {
+    return changeBetween<false>(date, date);
+}
+
+inline int AvailabilityCalendar::lowestChangeBetween(const Date &from, const Date &to) const {
+    return changeBetween<false>(from, to);
+}
+
+inline int AvailabilityCalendar::highestChangeBetween(const Date &from, const Date &to) const {
+    return changeBetween<true>(from, to);
+}
@@ -0,0 +1,39 @@
+#include <vector>
+#include <string_view>
+#include <charconv>
+#include "../include/BookCatalog.h"
+
+inline BookCatalog::BookCatalog(size_t expectedSize) : isbns_(expectedSize) {
+    books_.reserve(expectedSize);
+}
+
+inline BookCatalog::BookCatalog(const UnorderedSet<Book> &books) : BookCatalog(books.size()) {
+    for (const Book& book : books) {
+        add(book);
+    }
+}
+
+inline BookRef BookCatalog::add(std::string_view isbn, std::string_view title, std::string_view author,
+                                std::string_view publisher, std::string_view yearPublished, int copies) {
+    BookRef book = isbns_.intern(isbn);
+    if (book < books_.size()) {
+        return book;
+    }
+    books_.push_back(BookView{arena_.store(isbn), arena_.store(title), arena_.store(author), arena_.store(publisher),
+                              arena_.store(yearPublished), parseYear(yearPublished), copies});
+    return book;
+}
+
+inline BookRef BookCatalog::add(const Book &book) {
+    return add(book.ISBN, book.title, book.author, book.publisher, book.yearPublished, book.copies);
+}
+
+inline int BookCatalog::parseYear(std::string_view yearPublished) {
+    int year = 0;
+    const char* end = yearPublished.data() + yearPublished.size();
+    std::from_chars_result parsed = std::from_chars(yearPublished.data(), end, year);
+    if (yearPublished.empty() || parsed.ec != std::errc() || parsed.ptr != end || year == UNKNOWN_YEAR) {
+        return UNKNOWN_YEAR;
+    }
+    return year;
+}
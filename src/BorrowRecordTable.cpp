@@ -0,0 +1,117 @@
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include "../include/BorrowRecordTable.h"
+#include "../include/RadixSort.h"
+
+inline BorrowRecordTable::BorrowRecordTable(const UnorderedSet<BorrowRecord> &records) {
+    reserve(records.size());
+    for (const BorrowRecord& record : records) {
+        append(record);
+    }
+}
+
+inline void BorrowRecordTable::reserve(size_t rows) {
+    patronIds_.reserve(rows);
+    bookIds_.reserve(rows);
+    checkoutDays_.reserve(rows);
+    returnDays_.reserve(rows);
+}
+
+inline void BorrowRecordTable::append(const BorrowRecord &record) {
+    append(record.patronId, record.bookISBN, record.checkoutDate.getDayNumber(), record.returnDate.getDayNumber());
+}
+
+inline void BorrowRecordTable::append(std::string_view patronId, std::string_view bookISBN, DayNumber checkoutDay,
+                                      DayNumber returnDay) {
+    appendIds(patrons_.intern(patronId), books_.intern(bookISBN), checkoutDay, returnDay);
+}
+
+inline void BorrowRecordTable::appendIds(uint32_t patron, uint32_t book, DayNumber checkoutDay, DayNumber returnDay) {
+    patronIds_.push_back(patron);
+    bookIds_.push_back(book);
+    checkoutDays_.push_back(checkoutDay);
+    returnDays_.push_back(returnDay);
+}
+
+inline BorrowRecord BorrowRecordTable::record(size_t row) const {
+    BorrowRecord record;
+    record.patronId = patrons_.resolve(patronIds_[row]);
+    record.bookISBN = books_.resolve(bookIds_[row]);
+    record.checkoutDate = Date::fromDayNumber(checkoutDays_[row]);
+    record.returnDate = Date::fromDayNumber(returnDays_[row]);
+    return record;
+}
+
+// Only the row numbers are radix sorted, the key column is read once per row
+inline std::vector<uint32_t> BorrowRecordTable::orderBy(Column column) const {
+    std::vector<uint32_t> order(size());
+    for (uint32_t row = 0; row < order.size(); ++row) {
+        order[row] = row;
+    }
+    if (column == Column::PATRON || column == Column::BOOK) {
+        const std::vector<uint32_t>& ids = column == Column::PATRON ? patronIds_ : bookIds_;
+        RadixSort<uint32_t, uint32_t> radixSort(order, [&](const uint32_t& row) { return ids[row]; });
+        radixSort.lsdSort();
+    } else {
+        const std::vector<DayNumber>& days = column == Column::CHECKOUT ? checkoutDays_ : returnDays_;
+        RadixSort<uint32_t, DayNumber> radixSort(order, [&](const uint32_t& row) { return days[row]; });
+        radixSort.lsdSort();
+    }
+    return order;
+}
+
+template <typename Value>
+void BorrowRecordTable::permute(std::vector<Value> &column, const std::vector<uint32_t> &order) {
+    std::vector<Value> sorted(column.size());
+    for (size_t row = 0; row < order.size(); ++row) {
+        sorted[row] = column[order[row]];
+    }
+    column.swap(sorted);
+}
+
+inline void BorrowRecordTable::sortBy(Column column) {
+    std::vector<uint32_t> order = orderBy(column);
+    permute(patronIds_, order);
+    permute(bookIds_, order);
+    permute(checkoutDays_, order);
+    permute(returnDays_, order);
+}
+
+inline long long BorrowRecordTable::totalBorrowingTime() const {
+    const DayNumber* checkout = checkoutDays_.data();
+    const DayNumber* returned = returnDays_.data();
+    long long total = 0;
+    for (size_t row = 0; row < size(); ++row) {
+        total += returned[row] - checkout[row];
+    }
+    return total;
+}
+
+inline std::vector<long long> BorrowRecordTable::borrowingTimeByBook() const {
+    std::vector<long long> totals(books_.size(), 0);
+    for (size_t row = 0; row < size(); ++row) {
+        totals[bookIds_[row]] += returnDays_[row] - checkoutDays_[row];
+    }
+    return totals;
+}
+
+inline std::vector<uint32_t> BorrowRecordTable::recordCountByPatron() const {
+    std::vector<uint32_t> counts(patrons_.size(), 0);
+    for (uint32_t patron : patronIds_) {
+        ++counts[patron];
+    }
+    return counts;
+}
+
+// Branch-free, so the comparison of both columns vectorises
+inline size_t BorrowRecordTable::activeOn(DayNumber day) const {
+    const DayNumber* checkout = checkoutDays_.data();
+    const DayNumber* returned = returnDays_.data();
+    size_t count = 0;
+    for (size_t row = 0; row < size(); ++row) {
+        count += static_cast<size_t>((checkout[row] <= day) & (day <= returned[row]));
+    }
+    return count;
+}
@@ -0,0 +1,133 @@
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "../include/CirculationEngine.h"
+
+inline CirculationEngine::CirculationEngine(const UnorderedSet<Book> &catalog)
+        : slots(static_cast<unsigned int>(catalog.size() * 2 + 1)), lastSlot(0) {
+    books.reserve(catalog.size());
+    for (const Book& book : catalog) {
+        if (slots.search(book.ISBN) == nullptr) {
+            slots.insert(book.ISBN, books.size());
+            books.push_back(book);
+        }
+    }
+    lastSlot = books.size();
+}
+
+inline size_t CirculationEngine::slotOf(const std::string &ISBN) {
+    if (lastSlot < books.size() && ISBN == lastISBN) {
+        return lastSlot;
+    }
+    size_t* slot = slots.search(ISBN);
+    if (slot == nullptr) {
+        return books.size();
+    }
+    lastISBN = ISBN;
+    lastSlot = *slot;
+    return lastSlot;
+}
+
+inline void CirculationEngine::buildLoanKey(const BorrowRecord &record, size_t slot) {
+    // The fixed-width fields go first, so the patron id that follows them needs no separator
+    uint32_t book = static_cast<uint32_t>(slot);
+    DayNumber days[2] = {record.checkoutDate.getDayNumber(), record.returnDate.getDayNumber()};
+    loanKey.assign(reinterpret_cast<const char*>(&book), sizeof(book));
+    loanKey.append(reinterpret_cast<const char*>(days), sizeof(days));
+    loanKey.append(record.patronId);
+}
+
+// Validates the dates before touching the catalog, so malformed records never reach the calendars. A return only
+// puts a copy back for a checkout the ledger still holds, so a rejected checkout can never release someone else's copy.
+inline CirculationStatus CirculationEngine::process(const BorrowRecord &record, bool isCheckout) {
+    if (record.returnDate < record.checkoutDate) {
+        return CirculationStatus::INVALID_DATES;
+    }
+    size_t slot = slotOf(record.bookISBN);
+    if (slot == books.size()) {
+        return CirculationStatus::UNKNOWN_BOOK;
+    }
+    Book& book = books[slot];
+    buildLoanKey(record, slot);
+    if (isCheckout) {
+        if (!book.tryReduceCopiesBetween(record.checkoutDate, record.returnDate)) {
+            return CirculationStatus::UNAVAILABLE;
+        }
+        uint32_t loan = loans.intern(loanKey);
+        if (loan == outstanding.size()) {
+            outstanding.push_back(0);
+        }
+        outstanding[loan]++;
+        return CirculationStatus::OK;
+    }
+    uint32_t loan = loans.lookup(loanKey);
+    if (loan == StringInterner::NOT_FOUND || outstanding[loan] == 0) {
+        return CirculationStatus::NOT_CHECKED_OUT;
+    }
+    outstanding[loan]--;
+    book.restoreCopiesBetween(record.checkoutDate, record.returnDate);
+    return CirculationStatus::OK;
+}
+
+inline CirculationStatus CirculationEngine::checkout(const BorrowRecord &record) {
+    return process(record, true);
+}
+
+inline CirculationStatus CirculationEngine::returnBook(const BorrowRecord &record) {
+    return process(record, false);
+}
+
+inline size_t CirculationEngine::checkoutBatch(const std::vector<BorrowRecord> &records,
+                                               std::vector<CirculationStatus> &statuses) {
+    statuses.resize(records.size());
+    size_t accepted = 0;
+    for (size_t i = 0; i < records.size(); ++i) {
+        statuses[i] = process(records[i], true);
+        accepted += statuses[i] == CirculationStatus::OK;
+    }
+    return accepted;
+}
+
+inline size_t CirculationEngine::returnBatch(const std::vector<BorrowRecord> &records,
+                                             std::vector<CirculationStatus> &statuses) {
+    statuses.resize(records.size());
+    size_t accepted = 0;
+    for (size_t i = 0; i < records.size(); ++i) {
+        statuses[i] = process(records[i], false);
+        accepted += statuses[i] == CirculationStatus::OK;
+    }
+    return accepted;
+}
+
+inline void CirculationEngine::throwFor(CirculationStatus status, const BorrowRecord &record) {
+    switch (status) {
+        case CirculationStatus::OK:
+            return;
+        case CirculationStatus::INVALID_DATES:
+            throw InvalidBorrowRecordDates();
+        case CirculationStatus::UNKNOWN_BOOK:
+            throw std::invalid_argument("Unknown ISBN: " + record.bookISBN);
+        case CirculationStatus::UNAVAILABLE:
+            throw UnavailableBookToBorrow(books[slotOf(record.bookISBN)]);
+        case CirculationStatus::NOT_CHECKED_OUT:
+            throw std::invalid_argument("No outstanding checkout matches this return: " + record.bookISBN);
+    }
+}
+
+inline void CirculationEngine::checkoutOrThrow(const BorrowRecord &record) {
+    throwFor(checkout(record), record);
+}
+
+inline void CirculationEngine::returnOrThrow(const BorrowRecord &record) {
+    throwFor(returnBook(record), record);
+}
+
+inline const Book *CirculationEngine::findBook(const std::string &ISBN) {
+    size_t slot = slotOf(ISBN);
+    return slot == books.size() ? nullptr : &books[slot];
+}
+
+inline int CirculationEngine::copiesOnDate(const std::string &ISBN, const Date &date) {
+    size_t slot = slotOf(ISBN);
+    return slot == books.size() ? -1 : books[slot].getCopiesOnDate(date);
+}
@@ -0,0 +1,132 @@
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include "../include/CsrGraph.h"
+
+inline CsrGraph::CsrGraph(std::vector<uint64_t> offsets, std::vector<uint32_t> targets,
+                          std::vector<uint32_t> weights)
+        : offsets_(std::move(offsets)), targets_(std::move(targets)), weights_(std::move(weights)) {
+    if (offsets_.empty() || offsets_[0] != 0 || offsets_.back() != targets_.size() ||
+        (!weights_.empty() && weights_.size() != targets_.size())) {
+        throw std::invalid_argument("Malformed CSR graph");
+    }
+    for (size_t vertex = 1; vertex < offsets_.size(); ++vertex) {
+        if (offsets_[vertex] < offsets_[vertex - 1]) {
+            throw std::invalid_argument("Malformed CSR graph");
+        }
+    }
+}
+
+// Rows are bucketed by patron with a counting sort, and lastPatron drops a patron's repeated borrows of a book
+// without clearing anything between patrons
+inline CsrGraph CsrGraph::patronBooks(const BorrowRecordTable &records) {
+    const std::vector<uint32_t>& patronIds = records.patronIds();
+    const std::vector<uint32_t>& bookIds = records.bookIds();
+    std::vector<uint64_t> rowOffsets(records.patrons().size() + 1, 0);
+    for (uint32_t patron : patronIds) {
+        ++rowOffsets[patron + 1];
+    }
+    for (size_t patron = 0; patron + 1 < rowOffsets.size(); ++patron) {
+        rowOffsets[patron + 1] += rowOffsets[patron];
+    }
+    std::vector<uint32_t> rowBooks(records.size());
+    std::vector<uint64_t> next(rowOffsets.begin(), rowOffsets.end() - 1);
+    for (size_t row = 0; row < records.size(); ++row) {
+        rowBooks[next[patronIds[row]]++] = bookIds[row];
+    }
+
+    std::vector<uint64_t> offsets(rowOffsets.size(), 0);
+    std::vector<uint32_t> lastPatron(records.books().size(), UINT32_MAX);
+    uint64_t write = 0;
+    for (uint32_t patron = 0; patron + 1 < rowOffsets.size(); ++patron) {
+        for (uint64_t row = rowOffsets[patron]; row < rowOffsets[patron + 1]; ++row) {
+            uint32_t book = rowBooks[row];
+            if (lastPatron[book] != patron) {
+                lastPatron[book] = patron;
+                rowBooks[write++] = book;
+            }
+        }
+        offsets[patron + 1] = write;
+    }
+    rowBooks.resize(write);
+    rowBooks.shrink_to_fit();
+    return CsrGraph(std::move(offsets), std::move(rowBooks));
+}
+
+inline CsrGraph CsrGraph::transpose(uint32_t targetCount) const {
+    std::vector<uint64_t> offsets(static_cast<size_t>(targetCount) + 1, 0);
+    for (uint32_t target : targets_) {
+        ++offsets[target + 1];
+    }
+    for (uint32_t target = 0; target < targetCount; ++target) {
+        offsets[target + 1] += offsets[target];
+    }
+    std::vector<uint32_t> sources(targets_.size());
+    std::vector<uint32_t> weights(weights_.size());
+    std::vector<uint64_t> next(offsets.begin(), offsets.end() - 1);
+    for (uint32_t vertex = 0; vertex < vertexCount(); ++vertex) {
+        for (uint64_t edge = offsets_[vertex]; edge < offsets_[vertex + 1]; ++edge) {
+            uint64_t position = next[targets_[edge]]++;
+            sources[position] = vertex;
+            if (!weights_.empty()) {
+                weights[position] = weights_[edge];
+            }
+        }
+    }
+    return CsrGraph(std::move(offsets), std::move(sources), std::move(weights));
+}
+
+inline CsrGraph CsrGraph::coBorrowGraph(const BorrowRecordTable &records, bool weighted) {
+    uint32_t bookCount = static_cast<uint32_t>(records.books().size());
+    CsrGraph booksOf = patronBooks(records);
+    CsrGraph patronsOf = booksOf.transpose(bookCount);
+
+    // Count pass; seen[b] == book marks b as already a neighbour of book
+    std::vector<uint32_t> seen(bookCount, UINT32_MAX);
+    std::vector<uint64_t> offsets(static_cast<size_t>(bookCount) + 1, 0);
+    for (uint32_t book = 0; book < bookCount; ++book) {
+        uint64_t degree = 0;
+        for (const uint32_t* patron = patronsOf.begin(book); patron != patronsOf.end(book); ++patron) {
+            for (const uint32_t* other = booksOf.begin(*patron); other != booksOf.end(*patron); ++other) {
+                if (*other != book && seen[*other] != book) {
+                    seen[*other] = book;
+                    ++degree;
+                }
+            }
+        }
+        offsets[book + 1] = offsets[book] + degree;
+    }
+
+    // Fill pass, in the same order; position[b] remembers where b went so that repeats add to its weight
+    std::vector<uint32_t> targets(offsets.back());
+    std::vector<uint32_t> weights(weighted ? targets.size() : 0);
+    std::vector<uint64_t> position(weighted ? bookCount : 0);
+    seen.assign(bookCount, UINT32_MAX);
+    for (uint32_t book = 0; book < bookCount; ++book) {
+        uint64_t write = offsets[book];
+        for (const uint32_t* patron = patronsOf.begin(book); patron != patronsOf.end(book); ++patron) {
+            for (const uint32_t* other = booksOf.begin(*patron); other != booksOf.end(*patron); ++other) {
+                if (*other == book) {
+                    continue;
+                }
+                if (seen[*other] != book) {
+                    seen[*other] = book;
+                    if (weighted) {
+                        position[*other] = write;
+                        weights[write] = 1;
+                    }
+                    targets[write++] = *other;
+                } else if (weighted) {
+                    ++weights[position[*other]];
+                }
+            }
+        }
+    }
+    return CsrGraph(std::move(offsets), std::move(targets), std::move(weights));
+}
+
+inline size_t CsrGraph::memoryBytes() const {
+    return offsets_.capacity() * sizeof(uint64_t) + targets_.capacity() * sizeof(uint32_t) +
+           weights_.capacity() * sizeof(uint32_t);
+}
@@ -0,0 +1,366 @@
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <charconv>
+#include <stdexcept>
+#include <exception>
+#include <thread>
+#include "../include/CsvLoader.h"
+
+inline void CsvField::appendTo(std::string &out) const {
+    if (!escaped) {
+        out.append(text);
+        return;
+    }
+    for (size_t i = 0; i < text.size(); ++i) {
+        out.push_back(text[i]);
+        // Skip the second quote of every doubled pair
+        if (text[i] == '"' && i + 1 < text.size() && text[i + 1] == '"') {
+            ++i;
+        }
+    }
+}
+
+inline std::string_view CsvField::value(std::string &scratch) const {
+    if (!escaped) {
+        return text;
+    }
+    scratch.clear();
+    appendTo(scratch);
+    return scratch;
+}
+
+inline bool CsvReader::next(std::vector<CsvField> &fields) {
+    fields.clear();
+    while (cursor_ < end_ && (*cursor_ == '\n' || *cursor_ == '\r')) {
+        ++cursor_;
+    }
+    if (cursor_ >= end_) {
+        return false;
+    }
+    while (true) {
+        if (cursor_ < end_ && *cursor_ == '"') {
+            const char* start = ++cursor_;
+            bool escaped = false;
+            const char* stop = end_;
+            while (cursor_ < end_) {
+                auto quote = static_cast<const char*>(std::memchr(cursor_, '"', end_ - cursor_));
+                if (quote == nullptr) {
+                    // Unterminated quote, the field runs to the end of the text
+                    cursor_ = end_;
+                    break;
+                }
+                if (quote + 1 < end_ && quote[1] == '"') {
+                    escaped = true;
+                    cursor_ = quote + 2;
+                    continue;
+                }
+                stop = quote;
+                cursor_ = quote + 1;
+                break;
+            }
+            fields.push_back(CsvField{std::string_view(start, stop - start), escaped});
+            // Anything between the closing quote and the delimiter is dropped
+            while (cursor_ < end_ && *cursor_ != ',' && *cursor_ != '\n') {
+                ++cursor_;
+            }
+        } else {
+            const char* start = cursor_;
+            while (cursor_ < end_ && *cursor_ != ',' && *cursor_ != '\n') {
+                ++cursor_;
+            }
+            const char* stop = cursor_;
+            if (stop > start && stop[-1] == '\r' && (cursor_ == end_ || *cursor_ == '\n')) {
+                --stop;
+            }
+            fields.push_back(CsvField{std::string_view(start, stop - start), false});
+        }
+        if (cursor_ < end_ && *cursor_ == ',') {
+            ++cursor_;
+            continue;
+        }
+        if (cursor_ < end_) {
+            ++cursor_;
+        }
+        return true;
+    }
+}
+
+// As in next(), a quote only opens a quoted field at the start of a field; anywhere else, in an unquoted field or
+// after a closing quote, it is an ordinary character. Between quoted fields the scan jumps from quote to quote, and a
+// cut is placed after the first line break outside quotes at or past each target offset.
+inline std::vector<std::pair<size_t, size_t>> CsvReader::splitRecords(std::string_view text, size_t count) {
+    std::vector<std::pair<size_t, size_t>> ranges;
+    const char* data = text.data();
+    size_t size = text.size();
+    // next() skips carriage returns at the start of a record, not after a delimiter
+    auto opensField = [&](size_t quote) {
+        size_t before = quote;
+        while (before > 0 && data[before - 1] == '\r') {
+            --before;
+        }
+        if (before == 0 || data[before - 1] == '\n') {
+            return true;
+        }
+        return before == quote && data[quote - 1] == ',';
+    };
+    // Position just past the quoted field opened at quote, the end of the text if it is never closed
+    auto skipQuoted = [&](size_t quote) {
+        size_t position = quote + 1;
+        while (position < size) {
+            auto next = static_cast<const char*>(std::memchr(data + position, '"', size - position));
+            if (next == nullptr) {
+                return size;
+            }
+            position = static_cast<size_t>(next - data) + 1;
+            if (position < size && data[position] == '"') {
+                ++position;
+                continue;
+            }
+            return position;
+        }
+        return size;
+    };
+    // Moves past the quote at offset, and past the whole field if the quote opens one
+    auto skipQuote = [&](const char* quote) {
+        size_t offset = static_cast<size_t>(quote - data);
+        return opensField(offset) ? skipQuoted(offset) : offset + 1;
+    };
+
+    size_t start = 0;
+    size_t position = 0;
+    for (size_t chunk = 1; chunk < count && position < size; ++chunk) {
+        size_t target = std::max(size / count * chunk, position);
+        while (position < target) {
+            auto quote = static_cast<const char*>(std::memchr(data + position, '"', target - position));
+            if (quote == nullptr) {
+                break;
+            }
+            position = skipQuote(quote);
+        }
+        position = std::max(position, target);
+        while (position < size) {
+            auto newline = static_cast<const char*>(std::memchr(data + position, '\n', size - position));
+            size_t lineEnd = newline == nullptr ? size : static_cast<size_t>(newline - data);
+            auto quote = static_cast<const char*>(std::memchr(data + position, '"', lineEnd - position));
+            if (quote != nullptr) {
+                position = skipQuote(quote);
+                continue;
+            }
+            position = newline == nullptr ? size : lineEnd + 1;
+            break;
+        }
+        if (position > start) {
+            ranges.emplace_back(start, position);
+            start = position;
+        }
+    }
+    if (start < size) {
+        ranges.emplace_back(start, size);
+    }
+    return ranges;
+}
+
+inline CsvLoader::CsvLoader(const std::string &path, unsigned int threadCount, bool hasHeader)
+        : file_(path), threadCount_(threadCount == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threadCount),
+          bodyOffset_(0) {
+    if (hasHeader) {
+        CsvReader reader(file_.text());
+        std::vector<CsvField> header;
+        reader.next(header);
+        bodyOffset_ = reader.offset(file_.text());
+    }
+}
+
+template <typename Row, typename Parse>
+std::vector<std::vector<Row>> CsvLoader::parseChunks(Parse parse) const {
+    std::string_view body = file_.text().substr(bodyOffset_);
+    std::vector<std::pair<size_t, size_t>> ranges = CsvReader::splitRecords(body, threadCount_);
+    std::vector<std::vector<Row>> rows(ranges.size());
+    std::vector<std::exception_ptr> errors(ranges.size());
+    auto work = [&](size_t chunk) {
+        try {
+            CsvReader reader(body.substr(ranges[chunk].first, ranges[chunk].second - ranges[chunk].first));
+            parse(reader, rows[chunk]);
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t chunk = 1; chunk < ranges.size(); ++chunk) {
+        workers.emplace_back(work, chunk);
+    }
+    if (!ranges.empty()) {
+        work(0);
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return rows;
+}
+
+inline void CsvLoader::requireFields(const std::vector<CsvField> &fields, size_t count, const char *kind) {
+    if (fields.size() < count) {
+        throw std::runtime_error(std::string("Malformed ") + kind + " record: expected " + std::to_string(count) +
+                                 " fields, found " + std::to_string(fields.size()));
+    }
+}
+
+inline int CsvLoader::parseInt(const CsvField &field, const char *kind) {
+    std::string scratch;
+    std::string_view text = field.value(scratch);
+    int value = 0;
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+        throw std::runtime_error(std::string("Malformed ") + kind + " record: bad number \"" + std::string(text) + "\"");
+    }
+    return value;
+}
+
+inline Date CsvLoader::parseDate(const CsvField &field) {
+    std::string scratch;
+    std::string_view text = field.value(scratch);
+    Date date(1970, 1, 1);
+    if (Date::tryParseDate(text, date) != DateParseError::NONE) {
+        throw std::runtime_error("Malformed borrow record: bad date \"" + std::string(text) + "\"");
+    }
+    return date;
+}
+
+inline std::vector<Book> CsvLoader::books() const {
+    std::vector<std::vector<Book>> chunks = parseChunks<Book>([](CsvReader& reader, std::vector<Book>& rows) {
+        std::vector<CsvField> fields;
+        while (reader.next(fields)) {
+            requireFields(fields, 6, "book");
+            rows.emplace_back();
+            Book& book = rows.back();
+            fields[0].appendTo(book.ISBN);
+            fields[1].appendTo(book.title);
+            fields[2].appendTo(book.author);
+            fields[3].appendTo(book.publisher);
+            fields[4].appendTo(book.yearPublished);
+            book.copies = parseInt(fields[5], "book");
+        }
+    });
+    std::vector<Book> books;
+    for (std::vector<Book>& chunk : chunks) {
+        books.insert(books.end(), std::make_move_iterator(chunk.begin()), std::make_move_iterator(chunk.end()));
+    }
+    return books;
+}
+
+// Chunks are tokenised and their copies parsed concurrently; the text is then copied into the arena in file order.
+inline BookCatalog CsvLoader::bookCatalog() const {
+    struct Row {
+        CsvField fields[5];
+        int copies;
+    };
+    std::vector<std::vector<Row>> chunks = parseChunks<Row>([](CsvReader& reader, std::vector<Row>& rows) {
+        std::vector<CsvField> fields;
+        while (reader.next(fields)) {
+            requireFields(fields, 6, "book");
+            rows.push_back(Row{{fields[0], fields[1], fields[2], fields[3], fields[4]}, parseInt(fields[5], "book")});
+        }
+    });
+    size_t total = 0;
+    for (const std::vector<Row>& chunk : chunks) {
+        total += chunk.size();
+    }
+    BookCatalog catalog(total);
+    std::string scratch[5];
+    for (const std::vector<Row>& chunk : chunks) {
+        for (const Row& row : chunk) {
+            catalog.add(row.fields[0].value(scratch[0]), row.fields[1].value(scratch[1]),
+                        row.fields[2].value(scratch[2]), row.fields[3].value(scratch[3]),
+                        row.fields[4].value(scratch[4]), row.copies);
+        }
+    }
+    return catalog;
+}
+
+inline std::vector<Patron> CsvLoader::patrons() const {
+    std::vector<std::vector<Patron>> chunks = parseChunks<Patron>([](CsvReader& reader, std::vector<Patron>& rows) {
+        std::vector<CsvField> fields;
+        while (reader.next(fields)) {
+            requireFields(fields, 5, "patron");
+            rows.emplace_back();
+            Patron& patron = rows.back();
+            fields[0].appendTo(patron.ID);
+            fields[1].appendTo(patron.name);
+            fields[2].appendTo(patron.email);
+            fields[3].appendTo(patron.location);
+            patron.age = fields[4].text == "-" ? -1 : parseInt(fields[4], "patron");
+        }
+    });
+    std::vector<Patron> patrons;
+    for (std::vector<Patron>& chunk : chunks) {
+        patrons.insert(patrons.end(), std::make_move_iterator(chunk.begin()), std::make_move_iterator(chunk.end()));
+    }
+    return patrons;
+}
+
+inline std::vector<BorrowRecord> CsvLoader::borrowRecords() const {
+    std::vector<std::vector<BorrowRecord>> chunks = parseChunks<BorrowRecord>(
+            [](CsvReader& reader, std::vector<BorrowRecord>& rows) {
+        std::vector<CsvField> fields;
+        while (reader.next(fields)) {
+            requireFields(fields, 4, "borrow");
+            rows.emplace_back();
+            BorrowRecord& record = rows.back();
+            fields[0].appendTo(record.patronId);
+            fields[1].appendTo(record.bookISBN);
+            record.checkoutDate = parseDate(fields[2]);
+            record.returnDate = parseDate(fields[3]);
+        }
+    });
+    std::vector<BorrowRecord> records;
+    for (std::vector<BorrowRecord>& chunk : chunks) {
+        records.insert(records.end(), std::make_move_iterator(chunk.begin()), std::make_move_iterator(chunk.end()));
+    }
+    return records;
+}
+
+// Chunks are tokenised, and their dates parsed and keys hashed, concurrently; the ids are then interned in file order
+// so that they come out the same whatever the thread count.
+inline BorrowRecordTable CsvLoader::borrowRecordTable() const {
+    struct Row {
+        CsvField patron;
+        CsvField book;
+        uint64_t patronHash;
+        uint64_t bookHash;
+        DayNumber checkoutDay;
+        DayNumber returnDay;
+    };
+    std::vector<std::vector<Row>> chunks = parseChunks<Row>([](CsvReader& reader, std::vector<Row>& rows) {
+        std::vector<CsvField> fields;
+        std::string scratch;
+        while (reader.next(fields)) {
+            requireFields(fields, 4, "borrow");
+            rows.push_back(Row{fields[0], fields[1], StringInterner::hash(fields[0].value(scratch)),
+                               StringInterner::hash(fields[1].value(scratch)), parseDate(fields[2]).getDayNumber(),
+                               parseDate(fields[3]).getDayNumber()});
+        }
+    });
+    size_t total = 0;
+    for (const std::vector<Row>& chunk : chunks) {
+        total += chunk.size();
+    }
+    BorrowRecordTable table;
+    table.reserve(total);
+    std::string patronScratch;
+    std::string bookScratch;
+    for (const std::vector<Row>& chunk : chunks) {
+        for (const Row& row : chunk) {
+            table.appendIds(table.patrons().intern(row.patron.value(patronScratch), row.patronHash),
+                            table.books().intern(row.book.value(bookScratch), row.bookHash), row.checkoutDay,
+                            row.returnDay);
+        }
+    }
+    return table;
+}
@@ -0,0 +1,36 @@
+#include <vector>
+#include <bitset>
+#include <cstdint>
+#include "../include/DenseBitset.h"
+
+inline bool DenseBitset::testAndSet(size_t bit) {
+    uint64_t mask = uint64_t(1) << (bit & 63);
+    uint64_t& word = words_[bit >> 6];
+    bool wasSet = (word & mask) != 0;
+    word |= mask;
+    return wasSet;
+}
+
+inline void DenseBitset::clear() {
+    for (uint64_t& word : words_) {
+        word = 0;
+    }
+}
+
+// Bits past the size are always kept clear, so growing never exposes old bits
+inline void DenseBitset::resize(size_t size) {
+    words_.resize((size + 63) / 64, 0);
+    if (size % 64 != 0) {
+        words_.back() &= (uint64_t(1) << (size % 64)) - 1;
+    }
+    size_ = size;
+}
+
+// std::bitset's count is portable and compiles down to the popcount instruction where there is one
+inline size_t DenseBitset::count() const {
+    size_t total = 0;
+    for (uint64_t word : words_) {
+        total += std::bitset<64>(word).count();
+    }
+    return total;
+}
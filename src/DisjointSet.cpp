@@ -0,0 +1,53 @@
+#include <vector>
+#include <cstdint>
+#include "../include/DisjointSet.h"
+
+inline DisjointSet::DisjointSet(uint32_t count) : components_(0) {
+    resize(count);
+}
+
+inline uint32_t DisjointSet::add() {
+    parent_.push_back(size());
+    size_.push_back(1);
+    ++components_;
+    return size() - 1;
+}
+
+inline void DisjointSet::resize(uint32_t count) {
+    parent_.reserve(count);
+    size_.reserve(count);
+    while (size() < count) {
+        add();
+    }
+}
+
+// Finds the root first, then points every element on the way straight at it
+inline uint32_t DisjointSet::find(uint32_t element) {
+    uint32_t root = element;
+    while (parent_[root] != root) {
+        root = parent_[root];
+    }
+    while (parent_[element] != root) {
+        uint32_t next = parent_[element];
+        parent_[element] = root;
+        element = next;
+    }
+    return root;
+}
+
+inline bool DisjointSet::unite(uint32_t a, uint32_t b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) {
+        return false;
+    }
+    if (size_[a] < size_[b]) {
+        uint32_t swap = a;
+        a = b;
+        b = swap;
+    }
+    parent_[b] = a;
+    size_[a] += size_[b];
+    --components_;
+    return true;
+}
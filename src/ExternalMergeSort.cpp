@@ -0,0 +1,308 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <functional>
+#include "../include/ExternalMergeSort.h"
+
+// Appends raw bytes to the buffer, writing the buffer to the file whenever it fills up.
+inline void RunWriter::writeBytes(const void *data, size_t length) {
+    const char* bytes = static_cast<const char*>(data);
+    while (length > 0) {
+        if (used == buffer.size()) {
+            flush();
+        }
+        size_t chunk = std::min(length, buffer.size() - used);
+        std::memcpy(buffer.data() + used, bytes, chunk);
+        used += chunk;
+        bytes += chunk;
+        length -= chunk;
+    }
+}
+
+// Writes an unsigned integer in LEB128 form, 7 bits per byte.
+inline void RunWriter::writeVarint(uint64_t value) {
+    char bytes[10];
+    size_t length = 0;
+    while (value >= 0x80) {
+        bytes[length++] = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    bytes[length++] = static_cast<char>(value);
+    writeBytes(bytes, length);
+}
+
+// Writes the buffered bytes to the file.
+inline void RunWriter::flush() {
+    if (used > 0 && std::fwrite(buffer.data(), 1, used, file) != used) {
+        throw std::runtime_error("Failed to write external sort run.");
+    }
+    used = 0;
+}
+
+// Reads the next chunk of the file into the buffer, returns false at the end of the file.
+inline bool RunReader::refill() {
+    available = std::fread(buffer.data(), 1, buffer.size(), file);
+    used = 0;
+    return available > 0;
+}
+
+// Copies the next length bytes of the file into data, returns false if the file ends first.
+inline bool RunReader::readBytes(void *data, size_t length) {
+    char* bytes = static_cast<char*>(data);
+    while (length > 0) {
+        if (used == available && !refill()) {
+            return false;
+        }
+        size_t chunk = std::min(length, available - used);
+        std::memcpy(bytes, buffer.data() + used, chunk);
+        used += chunk;
+        bytes += chunk;
+        length -= chunk;
+    }
+    return true;
+}
+
+// Reads an unsigned integer written by RunWriter::writeVarint, returns false at the end of the file.
+inline bool RunReader::readVarint(uint64_t &value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (used == available && !refill()) {
+            return false;
+        }
+        unsigned char byte = static_cast<unsigned char>(buffer[used++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+constexpr size_t ExternalMergeSort<T>::MIN_IO_BUFFER;
+
+// Closes any runs that were never merged, which also removes their temporary files.
+template <typename T>
+ExternalMergeSort<T>::~ExternalMergeSort() {
+    for (std::FILE* run : runs) {
+        std::fclose(run);
+    }
+}
+
+// Splits the memory budget evenly between the I/O buffers of the given number of streams.
+template <typename T>
+size_t ExternalMergeSort<T>::ioBufferSize(size_t streams) const {
+    size_t share = memoryBudget / streams;
+    return share > MIN_IO_BUFFER ? share : MIN_IO_BUFFER;
+}
+
+// Small budgets still leave three quarters of it to the buffered elements.
+template <typename T>
+size_t ExternalMergeSort<T>::spillBufferSize() const {
+    return std::max<size_t>(1, std::min(MIN_IO_BUFFER, memoryBudget / 4));
+}
+
+// The buffer grows by hand: while it reallocates, the old and the new array are both alive, so the new capacity is
+// capped by what the budget has left. A buffer with no room left to grow is spilled, which keeps its array.
+template <typename T>
+void ExternalMergeSort<T>::growBuffer() {
+    size_t runBudget = memoryBudget > spillBufferSize() ? memoryBudget - spillBufferSize() : 0;
+    size_t room = runBudget > bufferedBytes ? (runBudget - bufferedBytes) / sizeof(T) : 0;
+    size_t grown = std::min(std::max<size_t>(2 * buffer.capacity(), 16), room);
+    if (grown <= buffer.capacity()) {
+        if (!buffer.empty()) {
+            spillRun();
+            return;
+        }
+        // Not even one element fits the budget
+        grown = buffer.capacity() + 1;
+    }
+    // The footprints of the buffered elements stand in for the old array until it is freed
+    recordUsage(bufferedBytes + grown * sizeof(T));
+    buffer.reserve(grown);
+}
+
+// Buffers the element, spilling the buffer as a sorted run when it outgrows the memory budget.
+template <typename T>
+void ExternalMergeSort<T>::add(const T &element) {
+    if (buffer.size() == buffer.capacity()) {
+        growBuffer();
+    }
+    bufferedBytes += ExternalRecordCodec<T>::footprint(element);
+    buffer.push_back(element);
+    recordUsage(residentBytes());
+    if (residentBytes() + spillBufferSize() >= memoryBudget) {
+        spillRun();
+    }
+}
+
+// Sorts the buffered elements and writes them to a new temporary file through the writer's slice of the budget.
+// The array is kept for the next run.
+template <typename T>
+void ExternalMergeSort<T>::spillRun() {
+    if (buffer.empty()) {
+        return;
+    }
+    MergeSort<T> runSort(compare);
+    runSort.adaptiveSort(buffer);
+
+    std::FILE* run = std::tmpfile();
+    if (run == nullptr) {
+        throw std::runtime_error("Failed to create a temporary file for an external sort run.");
+    }
+    RunWriter writer(run, spillBufferSize());
+    recordUsage(residentBytes() + spillBufferSize());
+    for (const T& element : buffer) {
+        ExternalRecordCodec<T>::write(writer, element);
+    }
+    writer.flush();
+    std::rewind(run);
+    runs.push_back(run);
+
+    buffer.clear();
+    bufferedBytes = 0;
+}
+
+// Merges the runs with a loser tree: internal nodes keep the loser of their match, so replacing the winner only
+// replays the log(k) matches on its leaf-to-root path.
+template <typename T>
+void ExternalMergeSort<T>::mergeRuns(const std::vector<std::FILE*> &inputs,
+                                     const std::function<void(const T &)> &output) {
+    size_t k = inputs.size();
+    size_t bufferSize = ioBufferSize(k + 1);
+    std::vector<RunReader> readers;
+    std::vector<T> heads(k);
+    std::vector<bool> exhausted(k, false);
+    readers.reserve(k);
+    // The reader buffers and the output's share of the budget, the loser tree, and the heads, which are followed as
+    // they grow
+    const size_t fixedBytes = (k + 1) * bufferSize + k * (sizeof(RunReader) + 3 * sizeof(size_t));
+    size_t headBytes = 0;
+    for (size_t i = 0; i < k; ++i) {
+        readers.emplace_back(inputs[i], bufferSize);
+        exhausted[i] = !ExternalRecordCodec<T>::read(readers[i], heads[i]);
+        headBytes += ExternalRecordCodec<T>::footprint(heads[i]);
+    }
+    recordUsage(fixedBytes + headBytes);
+
+    // Exhausted runs lose every match, ties go to the earlier run to keep the merge stable
+    auto beats = [&](size_t a, size_t b) {
+        if (exhausted[a] || exhausted[b]) {
+            return !exhausted[a];
+        }
+        if (compare(heads[a], heads[b])) {
+            return true;
+        }
+        return !compare(heads[b], heads[a]) && a < b;
+    };
+
+    // Leaves live at positions k..2k-1, losers of internal matches at 1..k-1
+    std::vector<size_t> winners(2 * k);
+    std::vector<size_t> losers(k);
+    for (size_t i = 0; i < k; ++i) {
+        winners[k + i] = i;
+    }
+    for (size_t node = k - 1; node >= 1; --node) {
+        size_t left = winners[2 * node];
+        size_t right = winners[2 * node + 1];
+        bool leftWins = beats(left, right);
+        winners[node] = leftWins ? left : right;
+        losers[node] = leftWins ? right : left;
+    }
+    size_t winner = winners[1];
+
+    while (!exhausted[winner]) {
+        output(heads[winner]);
+        headBytes -= ExternalRecordCodec<T>::footprint(heads[winner]);
+        exhausted[winner] = !ExternalRecordCodec<T>::read(readers[winner], heads[winner]);
+        headBytes += ExternalRecordCodec<T>::footprint(heads[winner]);
+        recordUsage(fixedBytes + headBytes);
+        for (size_t node = (winner + k) >> 1; node >= 1; node >>= 1) {
+            if (beats(losers[node], winner)) {
+                std::swap(losers[node], winner);
+            }
+        }
+    }
+
+    for (std::FILE* input : inputs) {
+        std::fclose(input);
+    }
+}
+
+// Merges all runs, in several passes if the budget cannot give every run an I/O buffer, and streams the result.
+template <typename T>
+void ExternalMergeSort<T>::sort(const std::function<void(const T &)> &output) {
+    // Everything fit in memory, no need to touch the disk
+    if (runs.empty()) {
+        MergeSort<T> memorySort(compare);
+        memorySort.adaptiveSort(buffer);
+        for (const T& element : buffer) {
+            output(element);
+        }
+        buffer.clear();
+        bufferedBytes = 0;
+        return;
+    }
+    spillRun();
+    // The merge buffers get the whole budget
+    std::vector<T>().swap(buffer);
+    std::vector<std::FILE*> pending;
+    pending.swap(runs);
+
+    // One I/O buffer is reserved for the output of each merge
+    size_t maxFanIn = memoryBudget / MIN_IO_BUFFER;
+    maxFanIn = maxFanIn > 3 ? maxFanIn - 1 : 2;
+    while (pending.size() > maxFanIn) {
+        std::vector<std::FILE*> merged;
+        for (size_t first = 0; first < pending.size(); first += maxFanIn) {
+            size_t last = std::min(pending.size(), first + maxFanIn);
+            std::vector<std::FILE*> group(pending.begin() + first, pending.begin() + last);
+            std::FILE* run = std::tmpfile();
+            if (run == nullptr) {
+                throw std::runtime_error("Failed to create a temporary file for an external sort run.");
+            }
+            RunWriter writer(run, ioBufferSize(group.size() + 1));
+            mergeRuns(group, [&](const T& element) { ExternalRecordCodec<T>::write(writer, element); });
+            writer.flush();
+            std::rewind(run);
+            merged.push_back(run);
+        }
+        pending.swap(merged);
+    }
+    mergeRuns(pending, output);
+}
+
+// Merges all runs into the given file.
+template <typename T>
+void ExternalMergeSort<T>::sortToFile(const std::string &path) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        throw std::runtime_error("Failed to open " + path + " for writing.");
+    }
+    // The merge already gives its output a share of the budget, and the in-memory sort leaves this slice free
+    RunWriter writer(file, spillBufferSize());
+    outputBytes = spillBufferSize();
+    sort([&](const T& element) { ExternalRecordCodec<T>::write(writer, element); });
+    outputBytes = 0;
+    writer.flush();
+    std::fclose(file);
+}
+
+// Streams every element stored in a file written by sortToFile.
+template <typename T>
+void ExternalMergeSort<T>::readFile(const std::string &path, const std::function<void(const T &)> &output) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        throw std::runtime_error("Failed to open " + path + " for reading.");
+    }
+    RunReader reader(file, MIN_IO_BUFFER);
+    T element;
+    while (ExternalRecordCodec<T>::read(reader, element)) {
+        output(element);
+    }
+    std::fclose(file);
+}
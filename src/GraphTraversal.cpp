@@ -0,0 +1,51 @@
+#include <vector>
+#include <cstdint>
+#include "../include/GraphTraversal.h"
+
+inline GraphTraversal::GraphTraversal(const uint64_t *offsets, const uint32_t *targets, uint32_t vertexCount)
+        : offsets_(offsets), targets_(targets), visited_(vertexCount) {}
+
+inline GraphTraversal::GraphTraversal(const CsrGraph &graph)
+        : GraphTraversal(graph.offsets().data(), graph.targets().data(), graph.vertexCount()) {}
+
+// Every frame resumes its scan where it stopped, which visits vertices in exactly the order the recursive version
+// would, with one frame per vertex on the current path instead of one call
+inline void GraphTraversal::depthFirst(uint32_t start, std::vector<uint32_t> &reached) {
+    if (visited_.testAndSet(start)) {
+        return;
+    }
+    reached.push_back(start);
+    frames_.push(Frame{start, offsets_[start]});
+    while (!frames_.isEmpty()) {
+        Frame& frame = frames_.top();
+        uint64_t end = offsets_[frame.vertex + 1];
+        while (frame.nextEdge < end && visited_.test(targets_[frame.nextEdge])) {
+            ++frame.nextEdge;
+        }
+        if (frame.nextEdge == end) {
+            frames_.pop();
+            continue;
+        }
+        uint32_t next = targets_[frame.nextEdge++];
+        visited_.set(next);
+        reached.push_back(next);
+        // May reallocate the stack's buffer, frame is not used past this point
+        frames_.push(Frame{next, offsets_[next]});
+    }
+}
+
+inline void GraphTraversal::breadthFirst(uint32_t start, std::vector<uint32_t> &reached) {
+    if (visited_.testAndSet(start)) {
+        return;
+    }
+    size_t head = reached.size();
+    reached.push_back(start);
+    while (head < reached.size()) {
+        uint32_t vertex = reached[head++];
+        for (uint64_t edge = offsets_[vertex]; edge < offsets_[vertex + 1]; ++edge) {
+            if (!visited_.testAndSet(targets_[edge])) {
+                reached.push_back(targets_[edge]);
+            }
+        }
+    }
+}
@@ -20,6 +20,15 @@ unsigned int hash(const KeyType& key) {
     return hash;
 }
 
+// Strings are hashed by their characters, their object representation holds a pointer to the heap buffer.
+inline unsigned int hash(const std::string& key) {
+    unsigned int hash = 0;
+    for (char c : key) {
+        hash = hash * 31 + static_cast<unsigned char>(c);
+    }
+    return hash;
+}
+
 template <typename KeyType, typename ValueType>
 unsigned int HashTable<KeyType, ValueType>::findFreeSlot(std::vector<Bucket> &cTable, unsigned int startIndex,
                                                          unsigned int &currentHop) {
@@ -37,36 +46,43 @@ unsigned int HashTable<KeyType, ValueType>::findFreeSlot(std::vector<Bucket> &cT
 
 template <typename KeyType, typename ValueType>
 void HashTable<KeyType, ValueType>::rehash() {
-    // Double size of hash table
-    unsigned int newSize = tableSize * 2;
-    std::vector<Bucket> newTable(newSize);
-
-    // Update hash table size
-    tableSize = newSize;
-
-    // Rehash all elements
-    for (auto& bucket : hashTable) {
-        if (bucket.occupied) {
-            unsigned int originalHash = hash(bucket.key);
-            unsigned int hash = originalHash % tableSize;
-            unsigned int hopInfo = 0;
-            unsigned int index = findFreeSlot(newTable, hash, hopInfo);
-
-            // If we couldn't find free slot, rehash later
-            if (index == std::numeric_limits<unsigned int>::max()) {
-                continue;
+    bool placedAll = false;
+    while (!placedAll) {
+        // Double size of hash table
+        unsigned int newSize = tableSize * 2;
+        std::vector<Bucket> newTable(newSize);
+
+        // Update hash table size
+        tableSize = newSize;
+
+        // Rehash all elements
+        placedAll = true;
+        for (auto& bucket : hashTable) {
+            if (bucket.occupied) {
+                unsigned int originalHash = hash(bucket.key);
+                unsigned int hash = originalHash % tableSize;
+                unsigned int hopInfo = 0;
+                unsigned int index = findFreeSlot(newTable, hash, hopInfo);
+
+                // If we couldn't find free slot, the table is still too crowded, double it again
+                if (index == std::numeric_limits<unsigned int>::max()) {
+                    placedAll = false;
+                    break;
+                }
+
+                // Insert the element into the new hash table
+                newTable[index].key = bucket.key;
+                newTable[index].value = bucket.value;
+                newTable[index].occupied = true;
+                newTable[index].hopInfo = hopInfo;
             }
+        }
 
-            // Insert the element into the new hash table
-            newTable[index].key = std::move(bucket.key);
-            newTable[index].value = std::move(bucket.value);
-            newTable[index].occupied = true;
-            newTable[index].hopInfo = hopInfo;
+        // Replace old hash table with new hash table
+        if (placedAll) {
+            hashTable = std::move(newTable);
         }
     }
-
-    // Replace old hash table with new hash table
-    hashTable = std::move(newTable);
 }
 
 template <typename KeyType, typename ValueType>
@@ -113,8 +129,8 @@ ValueType &HashTable<KeyType, ValueType>::operator[](const KeyType &key) {
     // If key not found, insert into hash table with default value
     insert(key, ValueType());
 
-    // Retrieve reference to newly inserted value
-    return hashTable[originalHash % tableSize].value;
+    // Retrieve reference to newly inserted value, which may have been probed past its home bucket or rehashed
+    return *search(key);
 }
 
 template <typename KeyType, typename ValueType>
@@ -149,7 +165,7 @@ void HashTable<KeyType, ValueType>::insert(const KeyType &key, const ValueType &
     // Find free slot for insertion
     unsigned int index = findFreeSlot(hashTable, hashValue, hashValue);
 
-    if (index == std::numeric_limits<unsigned int>::max()) {
+    while (index == std::numeric_limits<unsigned int>::max()) {
         rehash();
         index = findFreeSlot(hashTable, hashValue, hashValue);
     }
@@ -158,6 +174,7 @@ void HashTable<KeyType, ValueType>::insert(const KeyType &key, const ValueType &
     hashTable[index].key = key;
     hashTable[index].value = value;
     hashTable[index].occupied = true;
+    ++occupiedCount;
 }
 
 template <typename KeyType, typename ValueType>
@@ -189,6 +206,7 @@ bool HashTable<KeyType, ValueType>::remove(const KeyType &key) {
         if (hashTable[index].key == key) {
             // Found key, remove it
             hashTable[index].occupied = false;
+            --occupiedCount;
             return true;
         }
         index = (index + 1) % tableSize;
@@ -204,17 +222,12 @@ void HashTable<KeyType, ValueType>::clear() {
     for (Bucket& bucket : hashTable)  {
         bucket.occupied = false;
     }
+    occupiedCount = 0;
 }
 
 template <typename KeyType, typename ValueType>
 unsigned int HashTable<KeyType, ValueType>::size() const {
-    unsigned int count = 0;
-    for (const Bucket& bucket : hashTable) {
-        if (bucket.occupied) {
-            ++count;
-        }
-    }
-    return count;
+    return occupiedCount;
 }
 
 template <typename KeyType, typename ValueType>
@@ -3,116 +3,370 @@
 //
 #include <vector>
 #include <string>
+#include <string_view>
+#include <functional>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <stdexcept>
 #include "../include/Utils.h"
 #include "../include/UnorderedSet.h"
 #include "../include/HashTable.h"
 #include "../include/RadixSort.h"
 #include "../include/MergeSort.h"
+#include "../include/StringRadixSort.h"
+#include "../include/StringInterner.h"
+#include "../include/BorrowRecordTable.h"
+#include "../include/LibrarySnapshot.h"
+#include "../include/BookCatalog.h"
+#include "../include/CsrGraph.h"
+#include "../include/DisjointSet.h"
 #include "../include/Stack.h"
+#include "../include/DenseBitset.h"
+#include "../include/GraphTraversal.h"
 #include "../include/LibraryRestructuring.h"
 
-// Performs a depth first search on the graph.
-void LibraryRestructuring::dfs(const std::string &current, std::vector<std::string> &cluster,
-                               HashTable<std::string, bool> &visited) {
-    visited[current] = true;
-    cluster.push_back(current);
-    UnorderedSet<std::string>& neighbours = graph[current];
-    for (const std::string& neighbour : neighbours) {
-        if (!visited[neighbour]) {
-            dfs(neighbour, cluster, visited);
-        }
-    }
+uint32_t LibraryRestructuring::nodes() const {
+    return snapshot ? snapshot->nodeCount() : static_cast<uint32_t>(bookIds.size());
+}
+
+uint32_t LibraryRestructuring::roots() const {
+    return snapshot ? snapshot->rootCount() : rootCount;
+}
+
+const uint64_t *LibraryRestructuring::edgeOffsets() const {
+    return snapshot ? snapshot->edgeOffsets() : adjacency.offsets().data();
+}
+
+const uint32_t *LibraryRestructuring::edgeTargets() const {
+    return snapshot ? snapshot->edgeTargets() : adjacency.targets().data();
+}
+
+int64_t LibraryRestructuring::borrowingTimeOf(uint32_t book) const {
+    return snapshot ? snapshot->borrowingTime(book) : borrowingTimeById[book];
+}
+
+std::string_view LibraryRestructuring::isbnOf(uint32_t book) const {
+    return snapshot ? snapshot->string(snapshot->nodeIsbn(book)) : std::string_view(bookIds.resolve(book));
 }
 
 // Calculates the average borrowing time of a cluster.
-double LibraryRestructuring::getAverageBorrowingTime(const std::vector<std::string> &cluster) {
+double LibraryRestructuring::getAverageBorrowingTime(const std::vector<uint32_t> &cluster) {
     double totalBorrowingTime = 0.0;
-    for (const std::string& ISBN : cluster) {
-        totalBorrowingTime += bookBorrowingTime[ISBN];
+    for (uint32_t book : cluster) {
+        totalBorrowingTime += static_cast<double>(borrowingTimeOf(book));
     }
 
     return totalBorrowingTime / cluster.size();
 }
 
-// Constructs a library restructure. Fills all blocks, book borrowing time, and the graph.
-LibraryRestructuring::LibraryRestructuring(const UnorderedSet<BorrowRecord> &records,
-                                           const UnorderedSet<Book> &bookCollection) {
-    HashTable<std::string, Book> books = HashTable<std::string, Book>(bookCollection.size());
-    HashTable<std::string, int> borrowingTime = HashTable<std::string, int>(records.size());
-    HashTable<std::string, UnorderedSet<std::string>> borrowGraph = HashTable<std::string, UnorderedSet<std::string>>(
-            bookCollection.size());
-    for (const Book &book: bookCollection) {
-        books.insert(book.ISBN, book);
-    }
-    for (const BorrowRecord &record: records) {
-        UnorderedSet<std::string> edge;
-        borrowingTime[record.bookISBN] += Date::diffDuration(record.checkoutDate, record.returnDate);
-        for (const BorrowRecord &record1: records) {
-            if (record1.bookISBN != record.bookISBN && record1.patronId == record.patronId) {
-                edge.insert(record1.bookISBN);
+// Keys are views into the catalog or the snapshot's string pool, which clusterAndSort does not change.
+void LibraryRestructuring::shelfKeys(bool byTitle, std::vector<std::string_view> &keys) const {
+    keys.assign(nodes(), std::string_view());
+    for (uint32_t book = 0; book < nodes(); ++book) {
+        if (snapshot) {
+            uint32_t index = snapshot->nodeBook(book);
+            if (index != LibrarySnapshot::NO_BOOK) {
+                keys[book] = snapshot->string(byTitle ? snapshot->book(index).title : snapshot->book(index).author);
             }
+        } else if (catalogRefById[book] != BookCatalog::NOT_FOUND) {
+            const BookView& entry = catalog[catalogRefById[book]];
+            keys[book] = byTitle ? entry.title : entry.author;
         }
-        if (!borrowGraph.search(record.bookISBN)) {
-            borrowGraph.insert(record.bookISBN, edge);
-        } else {
-            borrowGraph[record.bookISBN] = edge;
+    }
+}
 
+void LibraryRestructuring::shelfYears(std::vector<int> &years) const {
+    years.assign(nodes(), BookCatalog::UNKNOWN_YEAR);
+    for (uint32_t book = 0; book < nodes(); ++book) {
+        if (snapshot) {
+            uint32_t index = snapshot->nodeBook(book);
+            if (index != LibrarySnapshot::NO_BOOK) {
+                years[book] = BookCatalog::parseYear(snapshot->string(snapshot->book(index).yearPublished));
+            }
+        } else if (catalogRefById[book] != BookCatalog::NOT_FOUND) {
+            years[book] = catalog[catalogRefById[book]].yearPublished;
         }
-        allBooks = books;
-        bookBorrowingTime = borrowingTime;
-        graph = borrowGraph;
     }
 }
 
-// Clusters the graph and sorts the clusters by average duration of borrowed time and either title, author,
-// or year published,
-std::vector<std::vector<std::string>> LibraryRestructuring::clusterAndSort(const std::string &sortBy) {
-    HashTable<std::string, bool> visited = HashTable<std::string, bool>(graph.size());
-    std::vector<std::vector<std::string>> clusters;
+// Constructs a library restructure. Fills all blocks, book borrowing time, and the graph. The records are copied into
+// a table once so that they can be grouped by patron, and a book's edges are the union over every patron who
+// borrowed it.
+LibraryRestructuring::LibraryRestructuring(const UnorderedSet<BorrowRecord> &records,
+                                           const UnorderedSet<Book> &bookCollection)
+        : LibraryRestructuring(BorrowRecordTable(records), BookCatalog(bookCollection)) {}
+
+// Constructs a library restructure from a borrow record table. A book's edges are the union over every patron who
+// borrowed it, and every borrowed book is a node, with or without neighbours.
+LibraryRestructuring::LibraryRestructuring(const BorrowRecordTable &records, const UnorderedSet<Book> &bookCollection,
+                                           ClusteringMode mode)
+        : LibraryRestructuring(records, BookCatalog(bookCollection), mode) {}
 
-    for (auto bucket: graph) {
-        if (!bucket->key.empty()) {
-            visited[bucket->key] = false;
+LibraryRestructuring::LibraryRestructuring(const BorrowRecordTable &records, BookCatalog bookCatalog,
+                                           ClusteringMode mode)
+        : catalog(std::move(bookCatalog)), bookIds(records.books()),
+          rootCount(static_cast<uint32_t>(records.books().size())), mode(mode), clusterThreads(1) {
+    if (mode == ClusteringMode::GRAPH) {
+        adjacency = CsrGraph::coBorrowGraph(records);
+    } else if (mode == ClusteringMode::BIPARTITE) {
+        booksOfPatron = CsrGraph::patronBooks(records);
+        patronsOfBook = booksOfPatron.transpose(rootCount);
+    } else {
+        // One pass over the rows; anchor holds the first book of every patron seen so far
+        components = DisjointSet(rootCount);
+        std::vector<uint32_t> anchor(records.patrons().size(), StringInterner::NOT_FOUND);
+        const std::vector<uint32_t>& patronIds = records.patronIds();
+        const std::vector<uint32_t>& bookIds = records.bookIds();
+        for (size_t row = 0; row < records.size(); ++row) {
+            uint32_t& first = anchor[patronIds[row]];
+            if (first == StringInterner::NOT_FOUND) {
+                first = bookIds[row];
+            } else {
+                components.unite(first, bookIds[row]);
+            }
         }
     }
+    borrowingTimeById.assign(rootCount, 0);
+    catalogRefById.assign(rootCount, BookCatalog::NOT_FOUND);
+    std::vector<long long> borrowingTime = records.borrowingTimeByBook();
+    for (uint32_t book = 0; book < rootCount; ++book) {
+        borrowingTimeById[book] = borrowingTime[book];
+        catalogRefById[book] = catalog.find(bookIds.resolve(book));
+    }
+}
 
-    for (auto bucket: graph) {
-        if (!bucket->key.empty()) {
-            if (!visited[bucket->key]) {
-                std::vector<std::string> cluster;
-                dfs(bucket->key, cluster, visited);
-                if (cluster.size() > 1) {
-                    clusters.push_back(cluster);
+// Every search root becomes a key, as every borrowed book was when the graph was built directly; each set is filled
+// right after its key is inserted, before a later insert can rehash it away. In BIPARTITE mode a book's neighbours are
+// the other books of its patrons.
+HashTable<std::string, UnorderedSet<std::string>> &LibraryRestructuring::getGraph() {
+    if (graph.size() == 0 && roots() > 0 && mode != ClusteringMode::UNION_FIND) {
+        graph = HashTable<std::string, UnorderedSet<std::string>>(roots() + 1);
+        const uint64_t* offsets = edgeOffsets();
+        const uint32_t* targets = edgeTargets();
+        for (uint32_t book = 0; book < roots(); ++book) {
+            std::string isbn(isbnOf(book));
+            graph.insert(isbn, UnorderedSet<std::string>());
+            UnorderedSet<std::string>* edges = graph.search(isbn);
+            if (mode == ClusteringMode::BIPARTITE) {
+                for (const uint32_t* patron = patronsOfBook.begin(book); patron != patronsOfBook.end(book); ++patron) {
+                    for (const uint32_t* other = booksOfPatron.begin(*patron); other != booksOfPatron.end(*patron);
+                         ++other) {
+                        if (*other != book) {
+                            edges->insert(std::string(isbnOf(*other)));
+                        }
+                    }
+                }
+            } else {
+                for (uint64_t edge = offsets[book]; edge < offsets[book + 1]; ++edge) {
+                    edges->insert(std::string(isbnOf(targets[edge])));
                 }
             }
         }
     }
+    return graph;
+}
 
-    RadixSort<std::vector<std::string>> radixSort = RadixSort<std::vector<std::string>>(clusters,
-                                                                                        [&](const std::vector<std::string> &cluster) {
-                                                                                            return getAverageBorrowingTime(
-                                                                                                    cluster);
-                                                                                        });
-    radixSort.sort();
+// Searches start from the roots in id order, so every cluster is found from its smallest id. Members are put in id
+// order as well, which makes the sorting stages below see the same input whichever way the clusters were found.
+std::vector<std::vector<uint32_t>> LibraryRestructuring::findClusters() {
+    std::vector<std::vector<uint32_t>> clusters;
+    if (mode == ClusteringMode::UNION_FIND) {
+        // Numbers every set by its smallest id; the members arrive in ascending order
+        std::vector<uint32_t> clusterOf(nodes(), StringInterner::NOT_FOUND);
+        for (uint32_t book = 0; book < nodes(); ++book) {
+            uint32_t root = components.find(book);
+            if (components.sizeOf(root) > 1) {
+                if (clusterOf[root] == StringInterner::NOT_FOUND) {
+                    clusterOf[root] = static_cast<uint32_t>(clusters.size());
+                    clusters.emplace_back();
+                    clusters.back().reserve(components.sizeOf(root));
+                }
+                clusters[clusterOf[root]].push_back(book);
+            }
+        }
+        return clusters;
+    }
 
-    for (auto &cluster: clusters) {
-        if (sortBy == "title") {
-            MergeSort<std::string> mergeSort = MergeSort<std::string>([&](const std::string &a, const std::string &b) {
-                return allBooks[a].title < allBooks[b].title;
-            });
-            mergeSort.sort(cluster);
-        } else if (sortBy == "author") {
-            MergeSort<std::string> mergeSort = MergeSort<std::string>([&](const std::string &a, const std::string &b) {
-                return allBooks[a].author < allBooks[b].author;
-            });\
-            mergeSort.sort(cluster);
-        } else if (sortBy == "yearPublished") {
-            MergeSort<std::string> mergeSort = MergeSort<std::string>([&](const std::string &a, const std::string &b) {
-                return allBooks[a].yearPublished < allBooks[b].yearPublished;
-            });
-            mergeSort.sort(cluster);
+    if (mode == ClusteringMode::BIPARTITE) {
+        // Alternates book -> patrons -> books; a patron is expanded only the first time one of its books is reached,
+        // so every incidence is read at most twice
+        DenseBitset bookSeen(nodes());
+        DenseBitset patronSeen(booksOfPatron.vertexCount());
+        Stack<uint32_t> pending;
+        for (uint32_t book = 0; book < nodes(); ++book) {
+            if (bookSeen.testAndSet(book)) {
+                continue;
+            }
+            std::vector<uint32_t> cluster;
+            pending.push(book);
+            while (!pending.isEmpty()) {
+                uint32_t current = pending.top();
+                pending.pop();
+                cluster.push_back(current);
+                for (const uint32_t* patron = patronsOfBook.begin(current); patron != patronsOfBook.end(current);
+                     ++patron) {
+                    if (patronSeen.testAndSet(*patron)) {
+                        continue;
+                    }
+                    for (const uint32_t* other = booksOfPatron.begin(*patron); other != booksOfPatron.end(*patron);
+                         ++other) {
+                        if (!bookSeen.testAndSet(*other)) {
+                            pending.push(*other);
+                        }
+                    }
+                }
+            }
+            if (cluster.size() > 1) {
+                RadixSort<uint32_t, uint32_t> idSort(cluster, [](const uint32_t &id) { return id; });
+                idSort.lsdSort();
+                clusters.push_back(std::move(cluster));
+            }
         }
+        return clusters;
     }
 
+    if (clusterThreads != 1) {
+        // Every book is labelled with the smallest id of its component, so numbering the clusters at their smallest
+        // member and walking the ids in order gives exactly what the search below gives
+        ParallelComponents engine(edgeOffsets(), edgeTargets(), nodes(), clusterThreads);
+        std::vector<uint32_t> labels = engine.labels();
+        std::vector<uint32_t> sizes(nodes(), 0);
+        for (uint32_t label : labels) {
+            ++sizes[label];
+        }
+        std::vector<uint32_t> clusterOf(nodes(), StringInterner::NOT_FOUND);
+        for (uint32_t book = 0; book < nodes(); ++book) {
+            uint32_t label = labels[book];
+            // Components without a root are never searched from
+            if (label >= roots() || sizes[label] < 2) {
+                continue;
+            }
+            if (label == book) {
+                clusterOf[book] = static_cast<uint32_t>(clusters.size());
+                clusters.emplace_back();
+                clusters.back().reserve(sizes[label]);
+            }
+            clusters[clusterOf[label]].push_back(book);
+        }
+        return clusters;
+    }
+
+    GraphTraversal traversal(edgeOffsets(), edgeTargets(), nodes());
+    // Books that only appear as neighbours are reached from their neighbours and never start a search
+    for (uint32_t book = 0; book < roots(); ++book) {
+        if (!traversal.visited(book)) {
+            std::vector<uint32_t> cluster;
+            traversal.depthFirst(book, cluster);
+            if (cluster.size() > 1) {
+                RadixSort<uint32_t, uint32_t> idSort(cluster, [](const uint32_t &id) { return id; });
+                idSort.lsdSort();
+                clusters.push_back(std::move(cluster));
+            }
+        }
+    }
     return clusters;
-}
\ No newline at end of file
+}
+
+void LibraryRestructuring::setClusterThreads(unsigned int threadCount) {
+    clusterThreads = threadCount;
+}
+
+// Clusters the graph and sorts the clusters by average duration of borrowed time and either title, author,
+// or year published,
+std::vector<std::vector<std::string>> LibraryRestructuring::clusterAndSort(const std::string &sortBy) {
+    std::vector<std::vector<uint32_t>> clusters = findClusters();
+
+    // Clusters are ordered by their exact (fractional) average, each average is computed once and every cluster is
+    // moved only once
+    RadixSort<std::vector<uint32_t>, double> radixSort = RadixSort<std::vector<uint32_t>, double>(
+            clusters, [&](const std::vector<uint32_t> &cluster) { return getAverageBorrowingTime(cluster); });
+    radixSort.indexSort();
+
+    // Titles and authors are compared as views into the catalog, years as the integers parsed when it was built
+    std::vector<std::string_view> keys;
+    std::vector<int> years;
+    if (sortBy == "title" || sortBy == "author") {
+        shelfKeys(sortBy == "title", keys);
+    } else if (sortBy == "yearPublished") {
+        shelfYears(years);
+    }
+    std::vector<std::vector<std::string>> result;
+    result.reserve(clusters.size());
+    for (auto &cluster: clusters) {
+        if (!keys.empty()) {
+            StringRadixSort<uint32_t, std::string_view> shelfSort(
+                    cluster, [&](const uint32_t &book) { return keys[book]; });
+            shelfSort.sort();
+        } else if (!years.empty()) {
+            RadixSort<uint32_t, int> shelfSort(cluster, [&](const uint32_t &book) { return years[book]; });
+            shelfSort.lsdSort();
+        }
+        std::vector<std::string> isbns;
+        isbns.reserve(cluster.size());
+        for (uint32_t book : cluster) {
+            isbns.emplace_back(isbnOf(book));
+        }
+        result.push_back(std::move(isbns));
+    }
+    return result;
+}
+
+// Strings are pooled once each; catalog books come first so that every graph node can point at its book by index.
+void LibraryRestructuring::saveSnapshot(const std::string &path) {
+    if (mode != ClusteringMode::GRAPH) {
+        throw std::logic_error("Only a restructuring with a co-borrow graph can be saved");
+    }
+    StringInterner pool;
+    LibrarySnapshot::Contents contents;
+    // Book index of every pooled ISBN
+    std::vector<uint32_t> bookByIsbn;
+    auto addBook = [&](std::string_view isbn, std::string_view title, std::string_view author,
+                       std::string_view publisher, std::string_view yearPublished, int copies) {
+        SnapshotBook entry{pool.intern(isbn), pool.intern(title), pool.intern(author), pool.intern(publisher),
+                           pool.intern(yearPublished), copies};
+        bookByIsbn.resize(pool.size(), LibrarySnapshot::NO_BOOK);
+        bookByIsbn[entry.isbn] = static_cast<uint32_t>(contents.books.size());
+        contents.books.push_back(entry);
+    };
+    if (snapshot) {
+        for (size_t index = 0; index < snapshot->bookCount(); ++index) {
+            const SnapshotBook& entry = snapshot->book(index);
+            addBook(snapshot->string(entry.isbn), snapshot->string(entry.title), snapshot->string(entry.author),
+                    snapshot->string(entry.publisher), snapshot->string(entry.yearPublished), entry.copies);
+        }
+    } else {
+        for (const BookView& book : catalog) {
+            addBook(book.ISBN, book.title, book.author, book.publisher, book.yearText, book.copies);
+        }
+    }
+
+    uint32_t n = nodes();
+    contents.rootCount = roots();
+    contents.nodeIsbns.resize(n);
+    contents.nodeBooks.resize(n);
+    contents.borrowingTimes.resize(n);
+    for (uint32_t book = 0; book < n; ++book) {
+        uint32_t isbn = pool.intern(isbnOf(book));
+        contents.nodeIsbns[book] = isbn;
+        contents.nodeBooks[book] = isbn < bookByIsbn.size() ? bookByIsbn[isbn] : LibrarySnapshot::NO_BOOK;
+        contents.borrowingTimes[book] = borrowingTimeOf(book);
+    }
+    const uint64_t* offsets = edgeOffsets();
+    const uint32_t* targets = edgeTargets();
+    contents.edgeOffsets.assign(offsets, offsets + n + 1);
+    contents.edgeTargets.assign(targets, targets + offsets[n]);
+
+    // Views are taken once the pool has stopped growing
+    contents.strings.reserve(pool.size());
+    for (uint32_t id = 0; id < pool.size(); ++id) {
+        contents.strings.emplace_back(pool.resolve(id));
+    }
+    LibrarySnapshot::write(path, contents);
+}
+
+LibraryRestructuring LibraryRestructuring::fromSnapshot(const std::string &path, bool verify) {
+    LibraryRestructuring restructuring;
+    restructuring.snapshot = std::make_shared<const LibrarySnapshot>(path, verify);
+    return restructuring;
+}
@@ -0,0 +1,182 @@
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include "../include/LibrarySnapshot.h"
+
+// Multiply-rotate mixing of every 64-bit word, enough to catch truncation and flipped bits
+inline uint64_t LibrarySnapshot::checksum(uint64_t state, const char *data, size_t size) {
+    for (size_t i = 0; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        state ^= word * 0xC2B2AE3D27D4EB4Full;
+        state = (state << 31 | state >> 33) * 0x9E3779B185EBCA87ull;
+    }
+    return state;
+}
+
+template <typename T>
+uint64_t LibrarySnapshot::writeSection(FILE *file, const T *data, size_t count, uint64_t &offset, uint64_t &state) {
+    uint64_t start = offset;
+    size_t bytes = count * sizeof(T);
+    size_t whole = bytes & ~size_t(7);
+    const char* raw = reinterpret_cast<const char*>(data);
+    char tail[8] = {0};
+    if (bytes != whole) {
+        std::memcpy(tail, raw + whole, bytes - whole);
+    }
+    size_t padded = bytes == whole ? 0 : 8;
+    // Empty sections may come from empty vectors whose data() is null
+    if ((whole > 0 && std::fwrite(raw, 1, whole, file) != whole) || std::fwrite(tail, 1, padded, file) != padded) {
+        throw std::runtime_error("Cannot write snapshot section");
+    }
+    if (whole > 0) {
+        state = checksum(state, raw, whole);
+    }
+    state = checksum(state, tail, padded);
+    offset += whole + padded;
+    return start;
+}
+
+inline void LibrarySnapshot::write(const std::string &path, const Contents &contents) {
+    // The string pool is stored as one block of text plus the offset of every string in it
+    std::vector<uint64_t> stringOffsets(contents.strings.size() + 1, 0);
+    for (size_t i = 0; i < contents.strings.size(); ++i) {
+        stringOffsets[i + 1] = stringOffsets[i] + contents.strings[i].size();
+    }
+    std::string stringBytes;
+    stringBytes.reserve(stringOffsets.back());
+    for (std::string_view value : contents.strings) {
+        stringBytes.append(value);
+    }
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+    try {
+        SnapshotHeader header{};
+        if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+            throw std::runtime_error("Cannot write snapshot header");
+        }
+        uint64_t offset = sizeof(header);
+        uint64_t state = CHECKSUM_SEED;
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.byteOrder = BYTE_ORDER_MARK;
+        header.stringCount = contents.strings.size();
+        header.stringByteCount = stringBytes.size();
+        header.stringOffsetsAt = writeSection(file, stringOffsets.data(), stringOffsets.size(), offset, state);
+        header.stringBytesAt = writeSection(file, stringBytes.data(), stringBytes.size(), offset, state);
+        header.bookCount = contents.books.size();
+        header.booksAt = writeSection(file, contents.books.data(), contents.books.size(), offset, state);
+        header.nodeCount = contents.nodeIsbns.size();
+        header.rootCount = contents.rootCount;
+        header.nodeIsbnsAt = writeSection(file, contents.nodeIsbns.data(), contents.nodeIsbns.size(), offset, state);
+        header.nodeBooksAt = writeSection(file, contents.nodeBooks.data(), contents.nodeBooks.size(), offset, state);
+        header.borrowingTimesAt = writeSection(file, contents.borrowingTimes.data(), contents.borrowingTimes.size(),
+                                               offset, state);
+        header.edgeCount = contents.edgeTargets.size();
+        header.edgeOffsetsAt = writeSection(file, contents.edgeOffsets.data(), contents.edgeOffsets.size(), offset,
+                                            state);
+        header.edgeTargetsAt = writeSection(file, contents.edgeTargets.data(), contents.edgeTargets.size(), offset,
+                                            state);
+        header.checksum = state;
+        header.fileSize = offset;
+        if (std::fseek(file, 0, SEEK_SET) != 0 || std::fwrite(&header, sizeof(header), 1, file) != 1) {
+            throw std::runtime_error("Cannot write snapshot header");
+        }
+    } catch (...) {
+        std::fclose(file);
+        throw;
+    }
+    if (std::fclose(file) != 0) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+}
+
+template <typename T>
+const T *LibrarySnapshot::section(uint64_t offset, uint64_t count) const {
+    if (offset % 8 != 0 || offset > file_.size() || count > (file_.size() - offset) / sizeof(T)) {
+        throw std::runtime_error("Snapshot section out of bounds");
+    }
+    return reinterpret_cast<const T*>(file_.data() + offset);
+}
+
+inline LibrarySnapshot::LibrarySnapshot(const std::string &path, bool verify) : file_(path) {
+    if (file_.size() < sizeof(SnapshotHeader)) {
+        throw std::runtime_error(path + " is not a library snapshot");
+    }
+    header_ = reinterpret_cast<const SnapshotHeader*>(file_.data());
+    if (std::memcmp(header_->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error(path + " is not a library snapshot");
+    }
+    if (header_->byteOrder != BYTE_ORDER_MARK) {
+        throw std::runtime_error(path + " was written on a host with another byte order");
+    }
+    if (header_->version != VERSION) {
+        throw std::runtime_error(path + " has unsupported snapshot version " + std::to_string(header_->version));
+    }
+    if (header_->fileSize != file_.size()) {
+        throw std::runtime_error(path + " is truncated");
+    }
+    stringOffsets_ = section<uint64_t>(header_->stringOffsetsAt, header_->stringCount + 1);
+    stringBytes_ = section<char>(header_->stringBytesAt, header_->stringByteCount);
+    books_ = section<SnapshotBook>(header_->booksAt, header_->bookCount);
+    nodeIsbns_ = section<uint32_t>(header_->nodeIsbnsAt, header_->nodeCount);
+    nodeBooks_ = section<uint32_t>(header_->nodeBooksAt, header_->nodeCount);
+    borrowingTimes_ = section<int64_t>(header_->borrowingTimesAt, header_->nodeCount);
+    edgeOffsets_ = section<uint64_t>(header_->edgeOffsetsAt, header_->nodeCount + 1);
+    edgeTargets_ = section<uint32_t>(header_->edgeTargetsAt, header_->edgeCount);
+    if (verify) {
+        uint64_t state = checksum(CHECKSUM_SEED, file_.data() + sizeof(SnapshotHeader),
+                                  file_.size() - sizeof(SnapshotHeader));
+        if (state != header_->checksum) {
+            throw std::runtime_error(path + " is corrupted (checksum mismatch)");
+        }
+        verifyContents();
+    }
+}
+
+// Every offset array must be non-decreasing and end at its section's size, and every id must name an existing entry
+inline void LibrarySnapshot::verifyContents() const {
+    auto fail = []() { throw std::runtime_error("Snapshot contents are inconsistent"); };
+    if (header_->rootCount > header_->nodeCount || header_->nodeCount > UINT32_MAX ||
+        header_->stringCount >= UINT32_MAX) {
+        fail();
+    }
+    if (stringOffsets_[0] != 0 || stringOffsets_[header_->stringCount] != header_->stringByteCount) {
+        fail();
+    }
+    for (uint64_t i = 0; i < header_->stringCount; ++i) {
+        if (stringOffsets_[i] > stringOffsets_[i + 1]) {
+            fail();
+        }
+    }
+    for (uint64_t i = 0; i < header_->bookCount; ++i) {
+        const SnapshotBook& entry = books_[i];
+        if (entry.isbn >= header_->stringCount || entry.title >= header_->stringCount ||
+            entry.author >= header_->stringCount || entry.publisher >= header_->stringCount ||
+            entry.yearPublished >= header_->stringCount) {
+            fail();
+        }
+    }
+    for (uint64_t node = 0; node < header_->nodeCount; ++node) {
+        if (nodeIsbns_[node] >= header_->stringCount ||
+            (nodeBooks_[node] != NO_BOOK && nodeBooks_[node] >= header_->bookCount) ||
+            edgeOffsets_[node] > edgeOffsets_[node + 1]) {
+            fail();
+        }
+    }
+    if (edgeOffsets_[0] != 0 || edgeOffsets_[header_->nodeCount] != header_->edgeCount) {
+        fail();
+    }
+    for (uint64_t edge = 0; edge < header_->edgeCount; ++edge) {
+        if (edgeTargets_[edge] >= header_->nodeCount) {
+            fail();
+        }
+    }
+}
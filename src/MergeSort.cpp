@@ -3,6 +3,8 @@
 //
 
 #include <vector>
+#include <algorithm>
+#include <iterator>
 #include <functional>
 #include "../include/MergeSort.h"
 
@@ -43,4 +45,464 @@ void MergeSort<T>::sort(std::vector<T> &arr) {
         sort(right);
         merge(arr, left, right);
     }
-}
\ No newline at end of file
+}
+
+// Computes the minimum run length for the adaptive sort, so that n / minRun is close to (but not above) a power of 2.
+template <typename T>
+long MergeSort<T>::computeMinRun(long n) const {
+    long r = 0;
+    while (n >= MIN_MERGE) {
+        r |= (n & 1);
+        n >>= 1;
+    }
+    return n + r;
+}
+
+// Returns the length of the natural run starting at lo, reversing it in place if it is strictly descending.
+template <typename T>
+long MergeSort<T>::countRunAndMakeAscending(std::vector<T> &arr, long lo, long hi) {
+    long runHi = lo + 1;
+    if (runHi == hi) {
+        return 1;
+    }
+
+    if (compare(arr[runHi++], arr[lo])) {
+        // Strictly descending, so reversing it keeps the sort stable
+        while (runHi < hi && compare(arr[runHi], arr[runHi - 1])) {
+            runHi++;
+        }
+        std::reverse(arr.begin() + lo, arr.begin() + runHi);
+    } else {
+        while (runHi < hi && !compare(arr[runHi], arr[runHi - 1])) {
+            runHi++;
+        }
+    }
+    return runHi - lo;
+}
+
+// Sorts arr[lo, hi) with a binary insertion sort, given that arr[lo, start) is already sorted.
+template <typename T>
+void MergeSort<T>::binaryInsertionSort(std::vector<T> &arr, long lo, long hi, long start) {
+    if (start == lo) {
+        start++;
+    }
+    for (; start < hi; ++start) {
+        T pivot = std::move(arr[start]);
+        long left = lo;
+        long right = start;
+        while (left < right) {
+            long mid = left + ((right - left) >> 1);
+            if (compare(pivot, arr[mid])) {
+                right = mid;
+            } else {
+                left = mid + 1;
+            }
+        }
+        std::move_backward(arr.begin() + left, arr.begin() + start, arr.begin() + start + 1);
+        arr[left] = std::move(pivot);
+    }
+}
+
+// Returns the leftmost position in the sorted run at which key could be inserted, searching outwards from hint.
+template <typename T>
+long MergeSort<T>::gallopLeft(const T &key, const T *run, long length, long hint) {
+    long lastOffset = 0;
+    long offset = 1;
+    if (compare(run[hint], key)) {
+        // Gallop right until run[hint + lastOffset] < key <= run[hint + offset]
+        long maxOffset = length - hint;
+        while (offset < maxOffset && compare(run[hint + offset], key)) {
+            lastOffset = offset;
+            offset = (offset << 1) + 1;
+        }
+        if (offset > maxOffset) {
+            offset = maxOffset;
+        }
+        lastOffset += hint;
+        offset += hint;
+    } else {
+        // Gallop left until run[hint - offset] < key <= run[hint - lastOffset]
+        long maxOffset = hint + 1;
+        while (offset < maxOffset && !compare(run[hint - offset], key)) {
+            lastOffset = offset;
+            offset = (offset << 1) + 1;
+        }
+        if (offset > maxOffset) {
+            offset = maxOffset;
+        }
+        long previous = lastOffset;
+        lastOffset = hint - offset;
+        offset = hint - previous;
+    }
+
+    // Binary search the remaining range (lastOffset, offset]
+    lastOffset++;
+    while (lastOffset < offset) {
+        long mid = lastOffset + ((offset - lastOffset) >> 1);
+        if (compare(run[mid], key)) {
+            lastOffset = mid + 1;
+        } else {
+            offset = mid;
+        }
+    }
+    return offset;
+}
+
+// Returns the rightmost position in the sorted run at which key could be inserted, searching outwards from hint.
+template <typename T>
+long MergeSort<T>::gallopRight(const T &key, const T *run, long length, long hint) {
+    long lastOffset = 0;
+    long offset = 1;
+    if (compare(key, run[hint])) {
+        // Gallop left until run[hint - offset] <= key < run[hint - lastOffset]
+        long maxOffset = hint + 1;
+        while (offset < maxOffset && compare(key, run[hint - offset])) {
+            lastOffset = offset;
+            offset = (offset << 1) + 1;
+        }
+        if (offset > maxOffset) {
+            offset = maxOffset;
+        }
+        long previous = lastOffset;
+        lastOffset = hint - offset;
+        offset = hint - previous;
+    } else {
+        // Gallop right until run[hint + lastOffset] <= key < run[hint + offset]
+        long maxOffset = length - hint;
+        while (offset < maxOffset && !compare(key, run[hint + offset])) {
+            lastOffset = offset;
+            offset = (offset << 1) + 1;
+        }
+        if (offset > maxOffset) {
+            offset = maxOffset;
+        }
+        lastOffset += hint;
+        offset += hint;
+    }
+
+    // Binary search the remaining range (lastOffset, offset]
+    lastOffset++;
+    while (lastOffset < offset) {
+        long mid = lastOffset + ((offset - lastOffset) >> 1);
+        if (compare(key, run[mid])) {
+            offset = mid;
+        } else {
+            lastOffset = mid + 1;
+        }
+    }
+    return offset;
+}
+
+// Merges pending runs until the stack invariants hold again:
+// runs[i - 2] > runs[i - 1] + runs[i] and runs[i - 1] > runs[i] for the top of the stack.
+template <typename T>
+void MergeSort<T>::mergeCollapse(std::vector<T> &arr, std::vector<Run> &runs) {
+    while (runs.size() > 1) {
+        long n = static_cast<long>(runs.size()) - 2;
+        if ((n > 0 && runs[n - 1].length <= runs[n].length + runs[n + 1].length) ||
+            (n > 1 && runs[n - 2].length <= runs[n - 1].length + runs[n].length)) {
+            if (runs[n - 1].length < runs[n + 1].length) {
+                n--;
+            }
+        } else if (runs[n].length > runs[n + 1].length) {
+            break;
+        }
+        mergeAt(arr, runs, n);
+    }
+}
+
+// Merges all the pending runs into one, once the whole array has been scanned.
+template <typename T>
+void MergeSort<T>::mergeForceCollapse(std::vector<T> &arr, std::vector<Run> &runs) {
+    while (runs.size() > 1) {
+        long n = static_cast<long>(runs.size()) - 2;
+        if (n > 0 && runs[n - 1].length < runs[n + 1].length) {
+            n--;
+        }
+        mergeAt(arr, runs, n);
+    }
+}
+
+// Merges the two adjacent runs at positions i and i + 1 of the run stack.
+template <typename T>
+void MergeSort<T>::mergeAt(std::vector<T> &arr, std::vector<Run> &runs, long i) {
+    long base1 = runs[i].base;
+    long len1 = runs[i].length;
+    long base2 = runs[i + 1].base;
+    long len2 = runs[i + 1].length;
+
+    runs[i].length = len1 + len2;
+    if (i == static_cast<long>(runs.size()) - 3) {
+        runs[i + 1] = runs[i + 2];
+    }
+    runs.pop_back();
+
+    // Elements of the first run that are already in place do not take part in the merge
+    long skip = gallopRight(arr[base2], &arr[base1], len1, 0);
+    base1 += skip;
+    len1 -= skip;
+    if (len1 == 0) {
+        return;
+    }
+
+    // Same for the elements at the end of the second run
+    len2 = gallopLeft(arr[base1 + len1 - 1], &arr[base2], len2, len2 - 1);
+    if (len2 == 0) {
+        return;
+    }
+
+    if (len1 <= len2) {
+        mergeLow(arr, base1, len1, base2, len2);
+    } else {
+        mergeHigh(arr, base1, len1, base2, len2);
+    }
+}
+
+// Merges two adjacent runs front to back, buffering the first (shorter) run.
+// Requires arr[base2] < arr[base1] and the last element of the first run to be greater than all of the second run.
+template <typename T>
+void MergeSort<T>::mergeLow(std::vector<T> &arr, long base1, long len1, long base2, long len2) {
+    mergeBuffer.assign(std::make_move_iterator(arr.begin() + base1),
+                       std::make_move_iterator(arr.begin() + base1 + len1));
+    long cursor1 = 0;
+    long cursor2 = base2;
+    long dest = base1;
+
+    arr[dest++] = std::move(arr[cursor2++]);
+    len2--;
+    long gallop = minGallop;
+    bool done = len2 == 0 || len1 == 1;
+    while (!done) {
+        long count1 = 0;
+        long count2 = 0;
+
+        // One element at a time until one run starts winning consistently
+        while (!done && (count1 | count2) < gallop) {
+            if (compare(arr[cursor2], mergeBuffer[cursor1])) {
+                arr[dest++] = std::move(arr[cursor2++]);
+                count2++;
+                count1 = 0;
+                done = --len2 == 0;
+            } else {
+                arr[dest++] = std::move(mergeBuffer[cursor1++]);
+                count1++;
+                count2 = 0;
+                done = --len1 == 1;
+            }
+        }
+
+        // Galloping mode, stays on while either run keeps winning by at least MIN_GALLOP elements
+        while (!done) {
+            count1 = gallopRight(arr[cursor2], &mergeBuffer[cursor1], len1, 0);
+            if (count1 != 0) {
+                std::move(mergeBuffer.begin() + cursor1, mergeBuffer.begin() + cursor1 + count1, arr.begin() + dest);
+                dest += count1;
+                cursor1 += count1;
+                len1 -= count1;
+                if (len1 <= 1) {
+                    done = true;
+                    break;
+                }
+            }
+            arr[dest++] = std::move(arr[cursor2++]);
+            if (--len2 == 0) {
+                done = true;
+                break;
+            }
+
+            count2 = gallopLeft(mergeBuffer[cursor1], &arr[cursor2], len2, 0);
+            if (count2 != 0) {
+                std::move(arr.begin() + cursor2, arr.begin() + cursor2 + count2, arr.begin() + dest);
+                dest += count2;
+                cursor2 += count2;
+                len2 -= count2;
+                if (len2 == 0) {
+                    done = true;
+                    break;
+                }
+            }
+            arr[dest++] = std::move(mergeBuffer[cursor1++]);
+            if (--len1 == 1) {
+                done = true;
+                break;
+            }
+
+            gallop--;
+            if (count1 < MIN_GALLOP && count2 < MIN_GALLOP) {
+                break;
+            }
+        }
+        if (!done) {
+            // Penalize leaving galloping mode
+            gallop = std::max(gallop, 0L) + 2;
+        }
+    }
+    minGallop = std::max(gallop, 1L);
+
+    if (len1 == 1) {
+        // The last element of the first run belongs after everything left in the second run
+        std::move(arr.begin() + cursor2, arr.begin() + cursor2 + len2, arr.begin() + dest);
+        arr[dest + len2] = std::move(mergeBuffer[cursor1]);
+    } else {
+        std::move(mergeBuffer.begin() + cursor1, mergeBuffer.begin() + cursor1 + len1, arr.begin() + dest);
+    }
+}
+
+// Merges two adjacent runs back to front, buffering the second (shorter) run.
+// Requires arr[base2] < arr[base1] and the last element of the first run to be greater than all of the second run.
+template <typename T>
+void MergeSort<T>::mergeHigh(std::vector<T> &arr, long base1, long len1, long base2, long len2) {
+    mergeBuffer.assign(std::make_move_iterator(arr.begin() + base2),
+                       std::make_move_iterator(arr.begin() + base2 + len2));
+    long cursor1 = base1 + len1 - 1;
+    long cursor2 = len2 - 1;
+    long dest = base2 + len2 - 1;
+
+    arr[dest--] = std::move(arr[cursor1--]);
+    len1--;
+    long gallop = minGallop;
+    bool done = len1 == 0 || len2 == 1;
+    while (!done) {
+        long count1 = 0;
+        long count2 = 0;
+
+        // One element at a time until one run starts winning consistently
+        while (!done && (count1 | count2) < gallop) {
+            if (compare(mergeBuffer[cursor2], arr[cursor1])) {
+                arr[dest--] = std::move(arr[cursor1--]);
+                count1++;
+                count2 = 0;
+                done = --len1 == 0;
+            } else {
+                arr[dest--] = std::move(mergeBuffer[cursor2--]);
+                count2++;
+                count1 = 0;
+                done = --len2 == 1;
+            }
+        }
+
+        // Galloping mode, stays on while either run keeps winning by at least MIN_GALLOP elements
+        while (!done) {
+            count1 = len1 - gallopRight(mergeBuffer[cursor2], &arr[base1], len1, len1 - 1);
+            if (count1 != 0) {
+                dest -= count1;
+                cursor1 -= count1;
+                len1 -= count1;
+                std::move_backward(arr.begin() + cursor1 + 1, arr.begin() + cursor1 + 1 + count1,
+                                   arr.begin() + dest + 1 + count1);
+                if (len1 == 0) {
+                    done = true;
+                    break;
+                }
+            }
+            arr[dest--] = std::move(mergeBuffer[cursor2--]);
+            if (--len2 == 1) {
+                done = true;
+                break;
+            }
+
+            count2 = len2 - gallopLeft(arr[cursor1], &mergeBuffer[0], len2, len2 - 1);
+            if (count2 != 0) {
+                dest -= count2;
+                cursor2 -= count2;
+                len2 -= count2;
+                std::move(mergeBuffer.begin() + cursor2 + 1, mergeBuffer.begin() + cursor2 + 1 + count2,
+                          arr.begin() + dest + 1);
+                if (len2 <= 1) {
+                    done = true;
+                    break;
+                }
+            }
+            arr[dest--] = std::move(arr[cursor1--]);
+            if (--len1 == 0) {
+                done = true;
+                break;
+            }
+
+            gallop--;
+            if (count1 < MIN_GALLOP && count2 < MIN_GALLOP) {
+                break;
+            }
+        }
+        if (!done) {
+            // Penalize leaving galloping mode
+            gallop = std::max(gallop, 0L) + 2;
+        }
+    }
+    minGallop = std::max(gallop, 1L);
+
+    if (len2 == 1) {
+        // The first element of the second run belongs before everything left in the first run
+        dest -= len1;
+        cursor1 -= len1;
+        std::move_backward(arr.begin() + cursor1 + 1, arr.begin() + cursor1 + 1 + len1,
+                           arr.begin() + dest + 1 + len1);
+        arr[dest] = std::move(mergeBuffer[cursor2]);
+    } else {
+        std::move(mergeBuffer.begin(), mergeBuffer.begin() + len2, arr.begin() + dest - (len2 - 1));
+    }
+}
+
+// Sorts the array by detecting natural runs and merging them, TimSort style.
+template <typename T>
+void MergeSort<T>::adaptiveSort(std::vector<T> &arr) {
+    long n = static_cast<long>(arr.size());
+    if (n < 2) {
+        return;
+    }
+    minGallop = MIN_GALLOP;
+
+    // Small arrays are a single run extended by insertion
+    if (n < MIN_MERGE) {
+        long initialRun = countRunAndMakeAscending(arr, 0, n);
+        binaryInsertionSort(arr, 0, n, initialRun);
+        return;
+    }
+
+    std::vector<Run> runs;
+    long minRun = computeMinRun(n);
+    long lo = 0;
+    long remaining = n;
+    while (remaining != 0) {
+        long runLength = countRunAndMakeAscending(arr, lo, n);
+
+        // Extend short runs to minRun so the merges stay balanced
+        if (runLength < minRun) {
+            long forced = remaining <= minRun ? remaining : minRun;
+            binaryInsertionSort(arr, lo, lo + forced, lo + runLength);
+            runLength = forced;
+        }
+
+        runs.push_back(Run{lo, runLength});
+        mergeCollapse(arr, runs);
+        lo += runLength;
+        remaining -= runLength;
+    }
+    mergeForceCollapse(arr, runs);
+    mergeBuffer.clear();
+    mergeBuffer.shrink_to_fit();
+}
+
+// Sorts the elements by their extracted keys, calling keyFunction once per element.
+template <typename T>
+template <typename Element, typename KeyFunction>
+void MergeSort<T>::sortByKey(std::vector<Element> &elements, KeyFunction keyFunction) {
+    std::vector<KeyedIndex> keyed;
+    keyed.reserve(elements.size());
+    for (size_t i = 0; i < elements.size(); ++i) {
+        keyed.push_back(KeyedIndex{keyFunction(elements[i]), i});
+    }
+
+    MergeSort<KeyedIndex> keySort([this](const KeyedIndex& a, const KeyedIndex& b) {
+        return compare(a.key, b.key);
+    });
+    keySort.adaptiveSort(keyed);
+
+    // Apply the permutation once, moving every element to its final position
+    std::vector<Element> sorted;
+    sorted.reserve(elements.size());
+    for (const KeyedIndex& entry : keyed) {
+        sorted.push_back(std::move(elements[entry.index]));
+    }
+    elements.swap(sorted);
+}
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include "../include/ParallelComponents.h"
+
+inline ParallelComponents::ParallelComponents(const uint64_t *offsets, const uint32_t *targets, uint32_t vertexCount,
+                                              unsigned int threadCount)
+        : offsets_(offsets), targets_(targets), vertexCount_(vertexCount), threadCount_(threadCount) {
+    if (threadCount_ == 0) {
+        threadCount_ = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+inline ParallelComponents::ParallelComponents(const CsrGraph &graph, unsigned int threadCount)
+        : ParallelComponents(graph.offsets().data(), graph.targets().data(), graph.vertexCount(), threadCount) {}
+
+template <typename Body>
+void ParallelComponents::forEachVertex(Body body) const {
+    // 64 bits so that claiming past the last vertex cannot wrap around
+    std::atomic<uint64_t> nextChunk(0);
+    auto work = [&]() {
+        for (;;) {
+            uint64_t begin = nextChunk.fetch_add(CHUNK_SIZE, std::memory_order_relaxed);
+            if (begin >= vertexCount_) {
+                return;
+            }
+            uint32_t end = static_cast<uint32_t>(std::min<uint64_t>(begin + CHUNK_SIZE, vertexCount_));
+            for (uint32_t vertex = static_cast<uint32_t>(begin); vertex < end; ++vertex) {
+                body(vertex);
+            }
+        }
+    };
+    // No more threads than there are chunks
+    unsigned int threads = static_cast<unsigned int>(
+            std::min<uint64_t>(threadCount_, (uint64_t(vertexCount_) + CHUNK_SIZE - 1) / CHUNK_SIZE));
+    std::vector<std::thread> workers;
+    for (unsigned int thread = 1; thread < threads; ++thread) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// Parents only ever point at smaller vertices, so a root is the smallest vertex of its tree. Halving can store a
+// plain value: once a vertex has a parent it keeps one, and a grandparent stays an ancestor whatever other threads
+// do. A root is only hooked while it is still a root, so relaxed ordering is enough, the threads are joined between
+// phases.
+inline uint32_t ParallelComponents::find(std::atomic<uint32_t> *parent, uint32_t vertex) {
+    for (;;) {
+        uint32_t next = parent[vertex].load(std::memory_order_relaxed);
+        if (next == vertex) {
+            return vertex;
+        }
+        uint32_t grandparent = parent[next].load(std::memory_order_relaxed);
+        if (grandparent == next) {
+            return next;
+        }
+        parent[vertex].store(grandparent, std::memory_order_relaxed);
+        vertex = grandparent;
+    }
+}
+
+inline void ParallelComponents::link(std::atomic<uint32_t> *parent, uint32_t a, uint32_t b) {
+    for (;;) {
+        a = find(parent, a);
+        b = find(parent, b);
+        if (a == b) {
+            return;
+        }
+        uint32_t high = std::max(a, b);
+        uint32_t low = std::min(a, b);
+        // Fails when another thread hooked high first, the next round starts from wherever it went
+        if (parent[high].compare_exchange_weak(high, low, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+inline uint32_t ParallelComponents::sampleLargest(const std::atomic<uint32_t> *parent) const {
+    std::vector<uint32_t> roots(SAMPLE_SIZE);
+    uint32_t seed = 12345;
+    for (uint32_t &root : roots) {
+        seed = seed * 1103515245 + 12345;
+        root = parent[(seed >> 8) % vertexCount_].load(std::memory_order_relaxed);
+    }
+    std::sort(roots.begin(), roots.end());
+    uint32_t largest = roots[0];
+    size_t largestRun = 0;
+    for (size_t begin = 0, end; begin < roots.size(); begin = end) {
+        for (end = begin + 1; end < roots.size() && roots[end] == roots[begin]; ++end) {}
+        if (end - begin > largestRun) {
+            largestRun = end - begin;
+            largest = roots[begin];
+        }
+    }
+    return largest;
+}
+
+inline std::vector<uint32_t> ParallelComponents::labels() const {
+    std::vector<uint32_t> result(vertexCount_);
+    if (vertexCount_ == 0) {
+        return result;
+    }
+    std::vector<std::atomic<uint32_t>> trees(vertexCount_);
+    std::atomic<uint32_t>* parent = trees.data();
+    forEachVertex([&](uint32_t vertex) { parent[vertex].store(vertex, std::memory_order_relaxed); });
+
+    for (uint32_t round = 0; round < SAMPLED_EDGES; ++round) {
+        forEachVertex([&](uint32_t vertex) {
+            if (offsets_[vertex] + round < offsets_[vertex + 1]) {
+                link(parent, vertex, targets_[offsets_[vertex] + round]);
+            }
+        });
+        // Points every vertex straight at its root, which is all the sampling and the skip below look at
+        forEachVertex([&](uint32_t vertex) {
+            parent[vertex].store(find(parent, vertex), std::memory_order_relaxed);
+        });
+    }
+
+    // Any edge between the largest component and another vertex is also stored at the other vertex, so the largest
+    // component's own vertices can skip their remaining edges
+    uint32_t largest = sampleLargest(parent);
+    forEachVertex([&](uint32_t vertex) {
+        if (parent[vertex].load(std::memory_order_relaxed) == largest) {
+            return;
+        }
+        for (uint64_t edge = offsets_[vertex] + SAMPLED_EDGES; edge < offsets_[vertex + 1]; ++edge) {
+            link(parent, vertex, targets_[edge]);
+        }
+    });
+    forEachVertex([&](uint32_t vertex) { result[vertex] = find(parent, vertex); });
+    return result;
+}
@@ -7,11 +7,12 @@
 #include <functional>
 #include <algorithm>
 #include <cmath>
+#include <thread>
 #include "../include/RadixSort.h"
 
 
-template <typename T>
-int RadixSort<T>::getDigitCount(int number) {
+template <typename T, typename Key>
+int RadixSort<T, Key>::getDigitCount(int number) {
     if (number == 0) {
         return 1;
     }
@@ -19,8 +20,8 @@ int RadixSort<T>::getDigitCount(int number) {
     return static_cast<int>(floor(log10(abs(number))) + 1);
 }
 
-template <typename T>
-int RadixSort<T>::getMaxDigitCount() {
+template <typename T, typename Key>
+int RadixSort<T, Key>::getMaxDigitCount() {
     int maxDigitCount = 0;
 
     for (const T& element : elements_) {
@@ -33,13 +34,13 @@ int RadixSort<T>::getMaxDigitCount() {
     return maxDigitCount;
 }
 
-template <typename T>
-int RadixSort<T>::getDigitValue(int number, int digit) {
+template <typename T, typename Key>
+int RadixSort<T, Key>::getDigitValue(int number, int digit) {
     return (number / static_cast<int>(pow(10, digit))) % 10;
 }
 
-template <typename T>
-void RadixSort<T>::countingSort(int digit) {
+template <typename T, typename Key>
+void RadixSort<T, Key>::countingSort(int digit) {
     int n = elements_.size();
 
     // Find maximum element to determine  range of counting array
@@ -75,8 +76,8 @@ void RadixSort<T>::countingSort(int digit) {
     }
 }
 
-template <typename T>
-void RadixSort<T>::sort() {
+template <typename T, typename Key>
+void RadixSort<T, Key>::sort() {
     // Get maximum number of digits
     int maxDigitCount = getMaxDigitCount();
 
@@ -84,4 +85,334 @@ void RadixSort<T>::sort() {
     for (int digit = 0; digit < maxDigitCount; ++digit) {
         countingSort(digit);
     }
-}
\ No newline at end of file
+}
+
+template <typename T, typename Key>
+void RadixSort<T, Key>::countDigits(Bits key, size_t *histograms, int digitBits) {
+    const size_t radix = size_t(1) << digitBits;
+    const Bits mask = static_cast<Bits>(radix - 1);
+    const int passes = static_cast<int>((sizeof(Bits) * 8 + digitBits - 1) / digitBits);
+    for (int pass = 0; pass < passes; ++pass) {
+        histograms[pass * radix + ((key >> (pass * digitBits)) & mask)]++;
+    }
+}
+
+template <typename T, typename Key>
+template <typename KeyAt, typename Scatter, typename Flip>
+void RadixSort<T, Key>::runPasses(size_t n, int digitBits, std::vector<size_t> &histograms, KeyAt keyAt,
+                                  Scatter scatter, Flip flip) {
+    const size_t radix = size_t(1) << digitBits;
+    const Bits mask = static_cast<Bits>(radix - 1);
+    const int passes = static_cast<int>((sizeof(Bits) * 8 + digitBits - 1) / digitBits);
+
+    for (int pass = 0; pass < passes; ++pass) {
+        int shift = pass * digitBits;
+        size_t* count = &histograms[pass * radix];
+
+        // Every key shares this digit, so the pass would not move anything
+        if (count[(keyAt(0) >> shift) & mask] == n) {
+            continue;
+        }
+
+        // Turn the counts into the first output position of each digit
+        size_t offset = 0;
+        for (size_t digit = 0; digit < radix; ++digit) {
+            size_t digitCount = count[digit];
+            count[digit] = offset;
+            offset += digitCount;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            scatter(i, count[(keyAt(i) >> shift) & mask]++);
+        }
+        flip();
+    }
+}
+
+template <typename T, typename Key>
+void RadixSort<T, Key>::lsdSort(int digitBits, SortOrder order) {
+    if (digitBits != 8 && digitBits != 11 && digitBits != 16) {
+        throw std::invalid_argument("Radix digits must be 8, 11 or 16 bits wide.");
+    }
+    size_t n = elements_.size();
+    if (n < 2) {
+        return;
+    }
+
+    const size_t radix = size_t(1) << digitBits;
+    const int passes = static_cast<int>((sizeof(Bits) * 8 + digitBits - 1) / digitBits);
+
+    // Evaluate every key once and count the digits of all passes at the same time. Inverting the bits reverses the
+    // order while equal keys still keep their relative order.
+    const Bits invert = order == SortOrder::DESCENDING ? static_cast<Bits>(~Bits(0)) : Bits(0);
+    std::vector<Bits> keys(n);
+    std::vector<size_t> histograms(passes * radix, 0);
+    for (size_t i = 0; i < n; ++i) {
+        Bits key = RadixKeyTraits<Key>::toBits(getKeyFunction_(elements_[i])) ^ invert;
+        keys[i] = key;
+        countDigits(key, histograms.data(), digitBits);
+    }
+
+    std::vector<Bits> keyBuffer(n);
+    std::vector<T> elementBuffer(n);
+    Bits* fromKeys = keys.data();
+    Bits* toKeys = keyBuffer.data();
+    T* from = elements_.data();
+    T* to = elementBuffer.data();
+    runPasses(n, digitBits, histograms, [&](size_t i) { return fromKeys[i]; },
+              [&](size_t i, size_t position) {
+                  toKeys[position] = fromKeys[i];
+                  to[position] = std::move(from[i]);
+              },
+              [&]() {
+                  std::swap(fromKeys, toKeys);
+                  std::swap(from, to);
+              });
+
+    // An odd number of passes leaves the result in the scratch buffer
+    if (from != elements_.data()) {
+        elements_.swap(elementBuffer);
+    }
+}
+
+template <typename T, typename Key>
+void RadixSort<T, Key>::indexSort(int digitBits, SortOrder order) {
+    if (digitBits != 8 && digitBits != 11 && digitBits != 16) {
+        throw std::invalid_argument("Radix digits must be 8, 11 or 16 bits wide.");
+    }
+    size_t n = elements_.size();
+    if (n < 2) {
+        return;
+    }
+    // Packed indexes are 32 bits wide
+    if (n > UINT32_MAX) {
+        lsdSort(digitBits, order);
+        return;
+    }
+
+    const Bits invert = order == SortOrder::DESCENDING ? static_cast<Bits>(~Bits(0)) : Bits(0);
+
+    // Evaluate every key exactly once and sort the packed keys alone
+    std::vector<KeyedIndex> keyed(n);
+    for (size_t i = 0; i < n; ++i) {
+        keyed[i] = KeyedIndex{RadixKeyTraits<Key>::toBits(getKeyFunction_(elements_[i])) ^ invert,
+                              static_cast<uint32_t>(i)};
+    }
+    sortKeyed(keyed, digitBits);
+
+    // Apply the permutation, moving every element exactly once
+    std::vector<T> sorted;
+    sorted.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        sorted.push_back(std::move(elements_[keyed[i].index]));
+    }
+    elements_.swap(sorted);
+}
+
+template <typename T, typename Key>
+void RadixSort<T, Key>::parallelSort(unsigned int threadCount, int digitBits, SortOrder order) {
+    if (digitBits != 8 && digitBits != 11 && digitBits != 16) {
+        throw std::invalid_argument("Radix digits must be 8, 11 or 16 bits wide.");
+    }
+    size_t n = elements_.size();
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // Below a few thousand elements per thread, starting the threads costs more than it saves
+    if (threadCount == 1 || n < threadCount * size_t(4096) || n > UINT32_MAX) {
+        indexSort(digitBits, order);
+        return;
+    }
+
+    const size_t radix = size_t(1) << digitBits;
+    const Bits mask = static_cast<Bits>(radix - 1);
+    const int passes = static_cast<int>((sizeof(Bits) * 8 + digitBits - 1) / digitBits);
+    const Bits invert = order == SortOrder::DESCENDING ? static_cast<Bits>(~Bits(0)) : Bits(0);
+    const size_t combineEntries = std::max<size_t>(1, WRITE_COMBINE_BYTES / sizeof(KeyedIndex));
+
+    // Runs body(thread, chunkBegin, chunkEnd) on every thread over disjoint chunks of the elements
+    auto runChunks = [&](const std::function<void(unsigned int, size_t, size_t)>& body) {
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount - 1);
+        for (unsigned int thread = 1; thread < threadCount; ++thread) {
+            workers.emplace_back(body, thread, n * thread / threadCount, n * (thread + 1) / threadCount);
+        }
+        body(0, 0, n / threadCount);
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    };
+
+    // Evaluate every key once; the per-thread histograms of all passes only decide which passes can be skipped
+    std::vector<KeyedIndex> keyed(n);
+    std::vector<size_t> counts(threadCount * radix * passes, 0);
+    runChunks([&](unsigned int thread, size_t begin, size_t end) {
+        size_t* histograms = &counts[thread * radix * passes];
+        for (size_t i = begin; i < end; ++i) {
+            Bits key = RadixKeyTraits<Key>::toBits(getKeyFunction_(elements_[i])) ^ invert;
+            keyed[i] = KeyedIndex{key, static_cast<uint32_t>(i)};
+            countDigits(key, histograms, digitBits);
+        }
+    });
+    std::vector<bool> skipPass(passes);
+    for (int pass = 0; pass < passes; ++pass) {
+        size_t sameDigit = 0;
+        size_t firstDigit = (keyed[0].key >> (pass * digitBits)) & mask;
+        for (unsigned int thread = 0; thread < threadCount; ++thread) {
+            sameDigit += counts[thread * radix * passes + pass * radix + firstDigit];
+        }
+        skipPass[pass] = sameDigit == n;
+    }
+
+    std::vector<KeyedIndex> buffer(n);
+    KeyedIndex* source = keyed.data();
+    KeyedIndex* target = buffer.data();
+    std::vector<size_t> offsets(threadCount * radix);
+    for (int pass = 0; pass < passes; ++pass) {
+        if (skipPass[pass]) {
+            continue;
+        }
+        int shift = pass * digitBits;
+
+        // Local histograms of the current order
+        runChunks([&](unsigned int thread, size_t begin, size_t end) {
+            size_t* count = &offsets[thread * radix];
+            std::fill(count, count + radix, 0);
+            for (size_t i = begin; i < end; ++i) {
+                count[(source[i].key >> shift) & mask]++;
+            }
+        });
+
+        // Digit-major, thread-minor prefix sum keeps equal digits in input order across threads
+        size_t offset = 0;
+        for (size_t digit = 0; digit < radix; ++digit) {
+            for (unsigned int thread = 0; thread < threadCount; ++thread) {
+                size_t count = offsets[thread * radix + digit];
+                offsets[thread * radix + digit] = offset;
+                offset += count;
+            }
+        }
+
+        runChunks([&](unsigned int thread, size_t begin, size_t end) {
+            size_t* next = &offsets[thread * radix];
+            std::vector<KeyedIndex> combine(radix * combineEntries);
+            std::vector<size_t> filled(radix, 0);
+            for (size_t i = begin; i < end; ++i) {
+                size_t digit = (source[i].key >> shift) & mask;
+                KeyedIndex* line = &combine[digit * combineEntries];
+                line[filled[digit]++] = source[i];
+                if (filled[digit] == combineEntries) {
+                    std::copy(line, line + combineEntries, target + next[digit]);
+                    next[digit] += combineEntries;
+                    filled[digit] = 0;
+                }
+            }
+            for (size_t digit = 0; digit < radix; ++digit) {
+                KeyedIndex* line = &combine[digit * combineEntries];
+                std::copy(line, line + filled[digit], target + next[digit]);
+                next[digit] += filled[digit];
+            }
+        });
+        std::swap(source, target);
+    }
+
+    // Apply the permutation in parallel, moving every element exactly once
+    std::vector<T> sorted(n);
+    runChunks([&](unsigned int, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            sorted[i] = std::move(elements_[source[i].index]);
+        }
+    });
+    elements_.swap(sorted);
+}
+
+template <typename T, typename Key>
+void RadixSort<T, Key>::sortKeyed(std::vector<KeyedIndex> &keyed, int digitBits) {
+    size_t n = keyed.size();
+    if (n < 2) {
+        return;
+    }
+    const size_t radix = size_t(1) << digitBits;
+    const int passes = static_cast<int>((sizeof(Bits) * 8 + digitBits - 1) / digitBits);
+
+    std::vector<size_t> histograms(passes * radix, 0);
+    for (const KeyedIndex& entry : keyed) {
+        countDigits(entry.key, histograms.data(), digitBits);
+    }
+
+    std::vector<KeyedIndex> buffer(n);
+    KeyedIndex* source = keyed.data();
+    KeyedIndex* target = buffer.data();
+    runPasses(n, digitBits, histograms, [&](size_t i) { return source[i].key; },
+              [&](size_t i, size_t position) { target[position] = source[i]; },
+              [&]() { std::swap(source, target); });
+    if (source != keyed.data()) {
+        keyed.swap(buffer);
+    }
+}
+
+template <typename T, typename Key>
+void RadixSort<T, Key>::partialSort(size_t k, SortOrder order) {
+    size_t n = elements_.size();
+    if (k >= n || n > UINT32_MAX) {
+        indexSort(8, order);
+        return;
+    }
+    if (k == 0) {
+        return;
+    }
+    const Bits invert = order == SortOrder::DESCENDING ? static_cast<Bits>(~Bits(0)) : Bits(0);
+
+    std::vector<KeyedIndex> candidates(n);
+    for (size_t i = 0; i < n; ++i) {
+        candidates[i] = KeyedIndex{RadixKeyTraits<Key>::toBits(getKeyFunction_(elements_[i])) ^ invert,
+                                   static_cast<uint32_t>(i)};
+    }
+
+    // Narrow the candidates down byte by byte from the most significant end. Filtering keeps the original order, and
+    // equal keys always land in the same bucket, so the final LSD sort of the selection is stable.
+    std::vector<KeyedIndex> selected;
+    selected.reserve(k);
+    size_t needed = k;
+    for (int shift = static_cast<int>(sizeof(Bits) * 8) - 8; shift >= 0 && needed > 0; shift -= 8) {
+        size_t count[256] = {0};
+        for (const KeyedIndex& entry : candidates) {
+            count[(entry.key >> shift) & 0xFF]++;
+        }
+        size_t before = 0;
+        size_t bucket = 0;
+        while (before + count[bucket] < needed) {
+            before += count[bucket++];
+        }
+
+        std::vector<KeyedIndex> remaining;
+        remaining.reserve(count[bucket]);
+        for (const KeyedIndex& entry : candidates) {
+            size_t digit = (entry.key >> shift) & 0xFF;
+            if (digit < bucket) {
+                selected.push_back(entry);
+            } else if (digit == bucket) {
+                remaining.push_back(entry);
+            }
+        }
+        needed -= before;
+        candidates.swap(remaining);
+    }
+    // Whatever is left has the same key, the earliest elements win
+    selected.insert(selected.end(), candidates.begin(), candidates.begin() + needed);
+
+    sortKeyed(selected, 8);
+
+    std::vector<bool> taken(n, false);
+    std::vector<T> arranged;
+    arranged.reserve(n);
+    for (const KeyedIndex& entry : selected) {
+        arranged.push_back(std::move(elements_[entry.index]));
+        taken[entry.index] = true;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (!taken[i]) {
+            arranged.push_back(std::move(elements_[i]));
+        }
+    }
+    elements_.swap(arranged);
+}
@@ -0,0 +1,226 @@
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "../include/ReservationQueue.h"
+
+template <typename T>
+constexpr size_t ReservationQueue<T>::CACHE_LINE_BYTES;
+template <typename T>
+constexpr size_t ReservationQueue<T>::CLOSED_BIT;
+template <typename T>
+constexpr unsigned int ReservationQueue<T>::SPIN_ROUNDS;
+template <typename T>
+constexpr unsigned int ReservationQueue<T>::YIELD_ROUNDS;
+
+// Cell i starts with sequence i, meaning it is free for the producer whose ticket is i.
+template <typename T>
+ReservationQueue<T>::ReservationQueue(size_t capacity) : tail_(0), head_(0), pushWaiters_(0), popWaiters_(0) {
+    size_t size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    cells_ = std::vector<Cell>(size);
+    mask_ = size - 1;
+    for (size_t i = 0; i < size; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+// A cell whose sequence equals the tail is free; one lagging by a full lap still holds an unread reservation, so the
+// queue is full. The store of tail + 1 hands the cell to the consumer with that ticket. The closed bit lives
+// in the tail itself, so the claiming compare-and-swap fails once close() has run.
+template <typename T>
+bool ReservationQueue<T>::pushCell(const T &reservation) {
+    size_t position = tail_.load(std::memory_order_relaxed);
+    while (true) {
+        if (position & CLOSED_BIT) {
+            return false;
+        }
+        Cell& cell = cells_[position & mask_];
+        size_t sequence = cell.sequence.load(std::memory_order_seq_cst);
+        auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+        if (difference == 0) {
+            if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                cell.reservation = reservation;
+                cell.sequence.store(position + 1, std::memory_order_seq_cst);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = tail_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// A cell whose sequence is head + 1 has been filled; anything lower means the producer has not got there yet. Reading
+// the cell frees it for the producer one lap ahead.
+template <typename T>
+bool ReservationQueue<T>::popCell(T &reservation) {
+    size_t position = head_.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = cells_[position & mask_];
+        size_t sequence = cell.sequence.load(std::memory_order_seq_cst);
+        auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+        if (difference == 0) {
+            if (head_.compare_exchange_weak(position, position + 1, std::memory_order_seq_cst)) {
+                reservation = std::move(cell.reservation);
+                cell.sequence.store(position + mask_ + 1, std::memory_order_seq_cst);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = head_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// A parked thread counts itself in waiters before its last check, and a successful push or pop changes the queue
+// before reading the count. Both sides are sequentially consistent (the cell sequences, the head, the closed bit and
+// the counts), so at least one of them sees the other. Taking the mutex before notifying means a thread that has
+// counted itself is either still checking, and will see the change, or already waiting.
+template <typename T>
+void ReservationQueue<T>::wake(const std::atomic<unsigned int> &waiters, std::condition_variable &condition,
+                               bool all) {
+    if (waiters.load(std::memory_order_seq_cst) == 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+    }
+    if (all) {
+        condition.notify_all();
+    } else {
+        condition.notify_one();
+    }
+}
+
+template <typename T>
+void ReservationQueue<T>::pushed() {
+    wake(popWaiters_, notEmpty_, false);
+}
+
+// The last pop of a closed queue also releases every consumer still waiting for more
+template <typename T>
+void ReservationQueue<T>::popped() {
+    wake(pushWaiters_, notFull_, false);
+    if (drained()) {
+        wake(popWaiters_, notEmpty_, true);
+    }
+}
+
+// A closed tail no longer moves, and a producer that claimed a cell before close() may still be filling it, so the
+// queue is drained only once the head has caught up with the tail.
+template <typename T>
+bool ReservationQueue<T>::drained() const {
+    size_t tail = tail_.load(std::memory_order_seq_cst);
+    return (tail & CLOSED_BIT) && head_.load(std::memory_order_seq_cst) == (tail & ~CLOSED_BIT);
+}
+
+template <typename T>
+bool ReservationQueue<T>::tryPush(const T &reservation) {
+    if (!pushCell(reservation)) {
+        return false;
+    }
+    pushed();
+    return true;
+}
+
+template <typename T>
+bool ReservationQueue<T>::tryPop(T &reservation) {
+    if (!popCell(reservation)) {
+        return false;
+    }
+    popped();
+    return true;
+}
+
+template <typename T>
+void ReservationQueue<T>::backoff(unsigned int round) {
+    if (round >= SPIN_ROUNDS) {
+        std::this_thread::yield();
+    }
+}
+
+// The parked attempts run under the mutex, so they must not wake anyone until it is released
+template <typename T>
+bool ReservationQueue<T>::push(const T &reservation) {
+    for (unsigned int round = 0; round < SPIN_ROUNDS + YIELD_ROUNDS; ++round) {
+        if (isClosed()) {
+            return false;
+        }
+        if (tryPush(reservation)) {
+            return true;
+        }
+        backoff(round);
+    }
+    bool success = false;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        pushWaiters_.fetch_add(1, std::memory_order_seq_cst);
+        while (!isClosed() && !(success = pushCell(reservation))) {
+            notFull_.wait(lock);
+        }
+        pushWaiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    if (success) {
+        pushed();
+    }
+    return success;
+}
+
+// Checks for closing only after a failed pop, so reservations pushed before close() are still handed out.
+template <typename T>
+bool ReservationQueue<T>::pop(T &reservation) {
+    for (unsigned int round = 0; round < SPIN_ROUNDS + YIELD_ROUNDS; ++round) {
+        if (tryPop(reservation)) {
+            return true;
+        }
+        if (drained()) {
+            return false;
+        }
+        backoff(round);
+    }
+    bool success = false;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        popWaiters_.fetch_add(1, std::memory_order_seq_cst);
+        while (!(success = popCell(reservation)) && !drained()) {
+            notEmpty_.wait(lock);
+        }
+        popWaiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    if (success) {
+        popped();
+    }
+    return success;
+}
+
+template <typename T>
+void ReservationQueue<T>::close() {
+    tail_.fetch_or(CLOSED_BIT, std::memory_order_seq_cst);
+    wake(pushWaiters_, notFull_, true);
+    wake(popWaiters_, notEmpty_, true);
+}
+
+template <typename T>
+void ReservationQueue<T>::pushOrThrow(const T &reservation) {
+    if (!tryPush(reservation)) {
+        if (isClosed()) {
+            throw LibraryReservationQueueClosed();
+        }
+        throw LibraryReservationQueueFull();
+    }
+}
+
+template <typename T>
+T ReservationQueue<T>::popOrThrow() {
+    T reservation;
+    if (!tryPop(reservation)) {
+        throw ReservationRecordUnavailable();
+    }
+    return reservation;
+}
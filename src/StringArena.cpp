@@ -0,0 +1,58 @@
+#include <vector>
+#include <string_view>
+#include <memory>
+#include <cstring>
+#include <utility>
+#include "../include/StringArena.h"
+
+inline StringArena::StringArena(size_t chunkSize)
+        : chunkSize_(chunkSize > 0 ? chunkSize : DEFAULT_CHUNK_SIZE), next_(nullptr), remaining_(0), bytes_(0) {}
+
+// The chunks change owner but not address, so views taken before the move stay valid
+inline StringArena::StringArena(StringArena &&other) noexcept
+        : chunkSize_(other.chunkSize_), chunks_(std::move(other.chunks_)), next_(other.next_),
+          remaining_(other.remaining_), bytes_(other.bytes_) {
+    other.chunks_.clear();
+    other.next_ = nullptr;
+    other.remaining_ = 0;
+    other.bytes_ = 0;
+}
+
+inline StringArena &StringArena::operator=(StringArena &&other) noexcept {
+    if (this != &other) {
+        chunkSize_ = other.chunkSize_;
+        chunks_ = std::move(other.chunks_);
+        next_ = other.next_;
+        remaining_ = other.remaining_;
+        bytes_ = other.bytes_;
+        other.chunks_.clear();
+        other.next_ = nullptr;
+        other.remaining_ = 0;
+        other.bytes_ = 0;
+    }
+    return *this;
+}
+
+inline std::string_view StringArena::store(std::string_view value) {
+    if (value.empty()) {
+        return std::string_view();
+    }
+    char* destination;
+    if (value.size() <= remaining_) {
+        destination = next_;
+        next_ += value.size();
+        remaining_ -= value.size();
+    } else if (value.size() > chunkSize_ / 4) {
+        // A long string gets a chunk of its own, and the chunk being filled keeps its free space
+        chunks_.push_back(std::unique_ptr<char[]>(new char[value.size()]));
+        destination = chunks_.back().get();
+    } else {
+        chunks_.push_back(std::unique_ptr<char[]>(new char[chunkSize_]));
+        destination = chunks_.back().get();
+        next_ = destination + value.size();
+        remaining_ = chunkSize_ - value.size();
+    }
+    std::memcpy(destination, value.data(), value.size());
+    bytes_ += value.size();
+    return std::string_view(destination, value.size());
+}
@@ -0,0 +1,83 @@
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include "../include/StringInterner.h"
+
+inline StringInterner::StringInterner(size_t expectedSize) {
+    reserve(expectedSize);
+}
+
+// 64-bit FNV-1a
+inline uint64_t StringInterner::hash(std::string_view value) {
+    uint64_t hashValue = 14695981039346656037ull;
+    for (char c : value) {
+        hashValue ^= static_cast<unsigned char>(c);
+        hashValue *= 1099511628211ull;
+    }
+    return hashValue;
+}
+
+// Linear probing; the table is never more than half full, so an empty slot is always reached
+inline size_t StringInterner::findSlot(std::string_view value, uint64_t hashValue) const {
+    size_t mask = slots_.size() - 1;
+    uint64_t tag = hashValue & ~uint64_t(0xFFFFFFFF);
+    for (size_t slot = hashValue & mask;; slot = (slot + 1) & mask) {
+        uint64_t entry = slots_[slot];
+        if (entry == 0) {
+            return slot;
+        }
+        if ((entry & ~uint64_t(0xFFFFFFFF)) == tag && strings_[(entry & 0xFFFFFFFF) - 1] == value) {
+            return slot;
+        }
+    }
+}
+
+inline void StringInterner::grow(size_t slotCount) {
+    slots_.assign(slotCount, 0);
+    size_t mask = slotCount - 1;
+    for (uint32_t id = 0; id < strings_.size(); ++id) {
+        size_t slot = hashes_[id] & mask;
+        while (slots_[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots_[slot] = slotEntry(hashes_[id], id);
+    }
+}
+
+inline void StringInterner::reserve(size_t expectedSize) {
+    size_t slotCount = 16;
+    while (slotCount < expectedSize * 2) {
+        slotCount <<= 1;
+    }
+    if (slotCount > slots_.size()) {
+        grow(slotCount);
+    }
+    strings_.reserve(expectedSize);
+    hashes_.reserve(expectedSize);
+}
+
+inline uint32_t StringInterner::intern(std::string_view value) {
+    return intern(value, hash(value));
+}
+
+inline uint32_t StringInterner::intern(std::string_view value, uint64_t hashValue) {
+    size_t slot = findSlot(value, hashValue);
+    if (slots_[slot] != 0) {
+        return static_cast<uint32_t>(slots_[slot] & 0xFFFFFFFF) - 1;
+    }
+    auto id = static_cast<uint32_t>(strings_.size());
+    strings_.emplace_back(value);
+    hashes_.push_back(hashValue);
+    if (strings_.size() * 2 > slots_.size()) {
+        grow(slots_.size() * 2);
+    } else {
+        slots_[slot] = slotEntry(hashValue, id);
+    }
+    return id;
+}
+
+inline uint32_t StringInterner::lookup(std::string_view value) const {
+    size_t slot = findSlot(value, hash(value));
+    return slots_[slot] == 0 ? NOT_FOUND : static_cast<uint32_t>(slots_[slot] & 0xFFFFFFFF) - 1;
+}
@@ -0,0 +1,144 @@
+#include <vector>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include "../include/StringRadixSort.h"
+
+template <typename T, typename Key>
+int StringRadixSort<T, Key>::digitAt(const KeyedIndex &entry, size_t depth) {
+    return depth < entry.key.size() ? static_cast<unsigned char>(entry.key[depth]) + 1 : 0;
+}
+
+template <typename T, typename Key>
+bool StringRadixSort<T, Key>::lessFrom(const KeyedIndex &a, const KeyedIndex &b, size_t depth) {
+    int order = a.key.substr(std::min(depth, a.key.size())).compare(b.key.substr(std::min(depth, b.key.size())));
+    return order < 0 || (order == 0 && a.index < b.index);
+}
+
+template <typename T, typename Key>
+void StringRadixSort<T, Key>::sortByIndex(std::vector<KeyedIndex> &keyed, size_t lo, size_t hi) {
+    std::sort(keyed.begin() + lo, keyed.begin() + hi, [](const KeyedIndex& a, const KeyedIndex& b) {
+        return a.index < b.index;
+    });
+}
+
+template <typename T, typename Key>
+void StringRadixSort<T, Key>::insertionSort(std::vector<KeyedIndex> &keyed, size_t lo, size_t hi, size_t depth) {
+    for (size_t i = lo + 1; i < hi; ++i) {
+        KeyedIndex entry = keyed[i];
+        size_t j = i;
+        while (j > lo && lessFrom(entry, keyed[j - 1], depth)) {
+            keyed[j] = keyed[j - 1];
+            --j;
+        }
+        keyed[j] = entry;
+    }
+}
+
+// Three-way partitions the range on the byte at depth, only the middle part moves on to the next byte.
+template <typename T, typename Key>
+void StringRadixSort<T, Key>::multikeyQuicksort(std::vector<KeyedIndex> &keyed, size_t lo, size_t hi, size_t depth) {
+    while (hi - lo >= INSERTION_THRESHOLD) {
+        int pivot = digitAt(keyed[lo + (hi - lo) / 2], depth);
+        size_t less = lo;
+        size_t greater = hi;
+        size_t i = lo;
+        while (i < greater) {
+            int digit = digitAt(keyed[i], depth);
+            if (digit < pivot) {
+                std::swap(keyed[less++], keyed[i++]);
+            } else if (digit > pivot) {
+                std::swap(keyed[i], keyed[--greater]);
+            } else {
+                ++i;
+            }
+        }
+
+        multikeyQuicksort(keyed, lo, less, depth);
+        multikeyQuicksort(keyed, greater, hi, depth);
+        if (pivot == 0) {
+            // Every key in the middle has ended, they are all equal
+            sortByIndex(keyed, less, greater);
+            return;
+        }
+        lo = less;
+        hi = greater;
+        depth++;
+    }
+    insertionSort(keyed, lo, hi, depth);
+}
+
+// Partitions the range in place into 257 buckets (end of key plus every byte value) by cycling each entry straight to
+// its bucket, then sorts every bucket on the next byte.
+template <typename T, typename Key>
+void StringRadixSort<T, Key>::americanFlagSort(std::vector<KeyedIndex> &keyed, size_t lo, size_t hi, size_t depth) {
+    if (hi - lo < QUICKSORT_THRESHOLD) {
+        multikeyQuicksort(keyed, lo, hi, depth);
+        return;
+    }
+
+    size_t count[257] = {0};
+    for (size_t i = lo; i < hi; ++i) {
+        count[digitAt(keyed[i], depth)]++;
+    }
+
+    size_t next[257];
+    size_t end[257];
+    size_t offset = lo;
+    for (int digit = 0; digit < 257; ++digit) {
+        next[digit] = offset;
+        offset += count[digit];
+        end[digit] = offset;
+    }
+
+    for (int digit = 0; digit < 257; ++digit) {
+        while (next[digit] < end[digit]) {
+            KeyedIndex entry = keyed[next[digit]];
+            int entryDigit = digitAt(entry, depth);
+            while (entryDigit != digit) {
+                std::swap(entry, keyed[next[entryDigit]++]);
+                entryDigit = digitAt(entry, depth);
+            }
+            keyed[next[digit]++] = entry;
+        }
+    }
+
+    // Keys which end here are equal, the rest continue on the next byte
+    size_t start = lo;
+    sortByIndex(keyed, start, start + count[0]);
+    start += count[0];
+    for (int digit = 1; digit < 257; ++digit) {
+        if (count[digit] > 1) {
+            americanFlagSort(keyed, start, start + count[digit], depth + 1);
+        }
+        start += count[digit];
+    }
+}
+
+template <typename T, typename Key>
+void StringRadixSort<T, Key>::sort() {
+    size_t n = elements_.size();
+    if (n < 2) {
+        return;
+    }
+
+    // Owning keys are kept alive here, views are used as they are
+    std::vector<Key> keys;
+    keys.reserve(n);
+    std::vector<KeyedIndex> keyed(n);
+    for (size_t i = 0; i < n; ++i) {
+        keys.push_back(getKeyFunction_(elements_[i]));
+    }
+    for (size_t i = 0; i < n; ++i) {
+        keyed[i] = KeyedIndex{std::string_view(keys[i]), i};
+    }
+
+    americanFlagSort(keyed, 0, n, 0);
+
+    std::vector<T> sorted;
+    sorted.reserve(n);
+    for (const KeyedIndex& entry : keyed) {
+        sorted.push_back(std::move(elements_[entry.index]));
+    }
+    elements_.swap(sorted);
+}
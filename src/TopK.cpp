@@ -0,0 +1,42 @@
+#include <vector>
+#include <algorithm>
+#include "../include/TopK.h"
+
+template <typename T, typename Key>
+bool TopK<T, Key>::precedes(const Entry &a, const Entry &b) const {
+    if (a.key < b.key || b.key < a.key) {
+        return order_ == SortOrder::ASCENDING ? a.key < b.key : b.key < a.key;
+    }
+    return a.sequence < b.sequence;
+}
+
+// Keeps the element if the heap is not full yet or if it beats the worst element kept so far.
+template <typename T, typename Key>
+void TopK<T, Key>::push(const T &element) {
+    if (k_ == 0) {
+        return;
+    }
+    Entry entry{getKeyFunction_(element), pushed_++, element};
+    auto heapOrder = [this](const Entry& a, const Entry& b) { return precedes(a, b); };
+    if (heap_.size() < k_) {
+        heap_.push_back(std::move(entry));
+        std::push_heap(heap_.begin(), heap_.end(), heapOrder);
+    } else if (precedes(entry, heap_.front())) {
+        std::pop_heap(heap_.begin(), heap_.end(), heapOrder);
+        heap_.back() = std::move(entry);
+        std::push_heap(heap_.begin(), heap_.end(), heapOrder);
+    }
+}
+
+// Sorts a copy of the heap into result order.
+template <typename T, typename Key>
+std::vector<T> TopK<T, Key>::result() const {
+    std::vector<Entry> entries = heap_;
+    std::sort(entries.begin(), entries.end(), [this](const Entry& a, const Entry& b) { return precedes(a, b); });
+    std::vector<T> elements;
+    elements.reserve(entries.size());
+    for (Entry& entry : entries) {
+        elements.push_back(std::move(entry.element));
+    }
+    return elements;
+}
@@ -0,0 +1,134 @@
+#ifndef AVAILABILITYTESTS_H
+#define AVAILABILITYTESTS_H
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "../include/Utils.h"
+#include "../include/AvailabilityCalendar.h"
+#include "TestEnvironment.h"
+
+std::pair<int, int> availabilityCalendarTests() {
+    int passedTests = 0;
+    AvailabilityCalendar calendar;
+    passedTests += a_assert(calendar.empty());
+    passedTests += a_assert(calendar.lowestChangeBetween(Date(2023, 1, 1), Date(2023, 12, 31)) == 0);
+    calendar.add(Date(2023, 9, 1), Date(2023, 9, 21), -1);
+    calendar.add(Date(2023, 9, 15), Date(2023, 10, 5), -1);
+    passedTests += a_assert(calendar.changeOn(Date(2023, 8, 31)) == 0);
+    passedTests += a_assert(calendar.changeOn(Date(2023, 9, 1)) == -1);
+    passedTests += a_assert(calendar.changeOn(Date(2023, 9, 20)) == -2);
+    passedTests += a_assert(calendar.changeOn(Date(2023, 10, 5)) == -1);
+    passedTests += a_assert(calendar.lowestChangeBetween(Date(2023, 8, 1), Date(2023, 9, 14)) == -1);
+    passedTests += a_assert(calendar.lowestChangeBetween(Date(2023, 9, 10), Date(2023, 12, 1)) == -2);
+    calendar.add(Date(2020, 1, 1), Date(2020, 1, 1), -3);
+    calendar.add(Date(2030, 1, 1), Date(2030, 2, 1), -1);
+    passedTests += a_assert(calendar.changeOn(Date(2020, 1, 1)) == -3);
+    passedTests += a_assert(calendar.changeOn(Date(2023, 9, 20)) == -2);
+    passedTests += a_assert(calendar.lowestChangeBetween(Date(2029, 1, 1), Date(2031, 1, 1)) == -1);
+    return std::make_pair(passedTests, 11);
+}
+
+std::pair<int, int> availabilityRandomTests() {
+    int passedTests = 0;
+    // Random range updates checked against a plain array of days, including ones that grow the window both ways
+    std::vector<int> days(2000, 0);
+    Date origin(2022, 1, 1);
+    AvailabilityCalendar calendar;
+    unsigned int state = 8042;
+    bool matches = true;
+    for (int i = 0; i < 3000 && matches; ++i) {
+        state = state * 1103515245u + 12345u;
+        int from = static_cast<int>((state >> 8) % days.size());
+        state = state * 1103515245u + 12345u;
+        int to = std::min<int>(static_cast<int>(days.size()) - 1, from + static_cast<int>((state >> 8) % 200));
+        int delta = (state >> 4) % 3 == 0 ? 1 : -1;
+        calendar.add(origin + from, origin + to, delta);
+        for (int day = from; day <= to; ++day) {
+            days[day] += delta;
+        }
+        state = state * 1103515245u + 12345u;
+        int lo = static_cast<int>((state >> 8) % days.size()) - 100;
+        int hi = lo + static_cast<int>((state >> 4) % 300);
+        int lowest = 0;
+        int highest = 0;
+        bool first = true;
+        for (int day = lo; day <= hi; ++day) {
+            int value = day >= 0 && day < static_cast<int>(days.size()) ? days[day] : 0;
+            lowest = first ? value : std::min(lowest, value);
+            highest = first ? value : std::max(highest, value);
+            first = false;
+        }
+        matches = calendar.lowestChangeBetween(origin + lo, origin + hi) == lowest &&
+                  calendar.highestChangeBetween(origin + lo, origin + hi) == highest &&
+                  calendar.changeOn(origin + lo) == (lo >= 0 ? days[lo] : 0);
+    }
+    passedTests += a_assert(matches);
+    return std::make_pair(passedTests, 1);
+}
+
+std::pair<int, int> bookAvailabilityTests() {
+    int passedTests = 0;
+    TestEnvironment env;
+    Book book = env.book1;
+    book.copies = 2;
+    passedTests += a_assert(book.getCopiesOnDate(Date(2023, 9, 5)) == 2);
+    book.reduceCopiesBetween(Date(2023, 9, 1), Date(2023, 9, 21));
+    book.reduceCopiesOnDate(Date(2023, 9, 10));
+    passedTests += a_assert(book.getCopiesOnDate(Date(2023, 9, 10)) == 0);
+    passedTests += a_assert(book.getCopiesOnDate(Date(2023, 9, 11)) == 1);
+    passedTests += a_assert(!book.isAvailableBetween(Date(2023, 9, 5), Date(2023, 9, 15)));
+    passedTests += a_assert(book.isAvailableBetween(Date(2023, 9, 11), Date(2023, 9, 30)));
+    bool thrown = false;
+    try {
+        book.reduceCopiesOnDate(Date(2023, 9, 10));
+    } catch (const std::exception&) {
+        thrown = true;
+    }
+    passedTests += a_assert(thrown);
+    Book copy = book;
+    book.restoreCopiesBetween(Date(2023, 9, 1), Date(2023, 9, 21));
+    passedTests += a_assert(book.getCopiesOnDate(Date(2023, 9, 10)) == 1);
+    passedTests += a_assert(copy.getCopiesOnDate(Date(2023, 9, 10)) == 0);
+    return std::make_pair(passedTests, 8);
+}
+
+// A typo date centuries away widens the window without allocating a node per day in between
+std::pair<int, int> availabilityOutlierTests() {
+    int passedTests = 0;
+    AvailabilityCalendar calendar;
+    calendar.add(Date(2023, 9, 1), Date(2023, 9, 21), -1);
+    size_t before = calendar.nodeCount();
+    calendar.add(Date(1, 1, 1), Date(1, 1, 3), -1);
+    calendar.add(Date(9999, 12, 30), Date(9999, 12, 31), -2);
+    passedTests += a_assert(calendar.nodeCount() < before + 200);
+    passedTests += a_assert(calendar.changeOn(Date(1, 1, 2)) == -1 && calendar.changeOn(Date(1, 1, 4)) == 0);
+    passedTests += a_assert(calendar.changeOn(Date(9999, 12, 31)) == -2 && calendar.changeOn(Date(2023, 9, 10)) == -1);
+    passedTests += a_assert(calendar.lowestChangeBetween(Date(1, 1, 1), Date(9999, 12, 31)) == -2);
+    passedTests += a_assert(calendar.highestChangeBetween(Date(1000, 1, 1), Date(2023, 9, 5)) == 0);
+    passedTests += a_assert(calendar.lowestChangeBetween(Date(2, 1, 1), Date(9999, 1, 1)) == -1);
+    return std::make_pair(passedTests, 6);
+}
+
+int availabilityTests() {
+    int passedTests = 0;
+    int totalTests = 0;
+    std::pair<int, int> r1 = availabilityCalendarTests();
+    passedTests += r1.first;
+    totalTests += r1.second;
+    std::pair<int, int> r2 = bookAvailabilityTests();
+    passedTests += r2.first;
+    totalTests += r2.second;
+    std::pair<int, int> r3 = availabilityRandomTests();
+    passedTests += r3.first;
+    totalTests += r3.second;
+    std::pair<int, int> r4 = availabilityOutlierTests();
+    passedTests += r4.first;
+    totalTests += r4.second;
+    double grade = static_cast<double>(passedTests * 100) / totalTests;
+    grade = std::round(grade * 10) / 10;
+    std::cout << "Total tests passed: " << passedTests << " out of " << totalTests << " (" << grade << "%)"  << std::endl;
+    return 0;
+}
+
+#endif //AVAILABILITYTESTS_H
@@ -0,0 +1,156 @@
+#ifndef BOOKCATALOGTESTS_H
+#define BOOKCATALOGTESTS_H
+#include <iostream>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "../include/StringArena.h"
+#include "../include/BookCatalog.h"
+#include "../include/LibraryRestructuring.h"
+#include "TestEnvironment.h"
+
+std::pair<int, int> stringArenaTests() {
+    int passedTests = 0;
+    StringArena arena(64);
+    std::vector<std::string> values;
+    std::vector<std::string_view> views;
+    for (int i = 0; i < 200; ++i) {
+        values.push_back("value" + std::to_string(i * 7919));
+        views.push_back(arena.store(values.back()));
+    }
+    // Earlier views survive every later chunk, and a long string does not waste the chunk being filled
+    std::string longValue(1000, 'x');
+    std::string_view longView = arena.store(longValue);
+    std::string_view afterLong = arena.store("ab");
+    bool same = true;
+    for (size_t i = 0; i < values.size(); ++i) {
+        same = same && views[i] == values[i] && views[i].data() != values[i].data();
+    }
+    passedTests += a_assert(same);
+    passedTests += a_assert(longView == longValue && afterLong == "ab");
+    passedTests += a_assert(arena.chunkCount() > 1 && arena.chunkCount() < values.size());
+    passedTests += a_assert(arena.store("").empty());
+
+    // Moving the arena keeps the views valid
+    size_t bytes = arena.bytes();
+    StringArena moved(std::move(arena));
+    passedTests += a_assert(views[0] == values[0] && longView == longValue && moved.bytes() == bytes);
+    passedTests += a_assert(moved.store("after move") == "after move" && arena.bytes() == 0);
+    return std::make_pair(passedTests, 6);
+}
+
+std::pair<int, int> bookCatalogTests1() {
+    int passedTests = 0;
+    TestEnvironment env;
+    env.book1.yearPublished = "1999";
+    env.book2.yearPublished = "-";
+    env.book1.copies = 3;
+    BookCatalog catalog;
+    BookRef first = catalog.add(env.book1);
+    BookRef second = catalog.add(env.book2);
+    passedTests += a_assert(first == 0 && second == 1 && catalog.size() == 2);
+    passedTests += a_assert(catalog.find(env.book2.ISBN) == second && catalog.find("missing") == BookCatalog::NOT_FOUND);
+    passedTests += a_assert(catalog[first].title == env.book1.title && catalog[first].author == env.book1.author);
+    passedTests += a_assert(catalog[first].yearPublished == 1999 && catalog[first].copies == 3);
+    passedTests += a_assert(catalog[second].yearPublished == BookCatalog::UNKNOWN_YEAR);
+    passedTests += a_assert(catalog[first].yearText == "1999" && catalog[second].yearText == "-");
+
+    // A repeated ISBN keeps the first book
+    Book repeated = env.book1;
+    repeated.title = "Another title";
+    passedTests += a_assert(catalog.add(repeated) == first && catalog.size() == 2);
+    passedTests += a_assert(catalog[first].title == env.book1.title);
+
+    passedTests += a_assert(BookCatalog::parseYear("2023") == 2023 && BookCatalog::parseYear("-12") == -12);
+    passedTests += a_assert(BookCatalog::parseYear("") == BookCatalog::UNKNOWN_YEAR);
+    passedTests += a_assert(BookCatalog::parseYear("19x9") == BookCatalog::UNKNOWN_YEAR);
+
+    UnorderedSet<Book> books;
+    books.insert(env.book3);
+    books.insert(env.book4);
+    books.insert(env.book5);
+    BookCatalog fromSet(books);
+    passedTests += a_assert(fromSet.size() == 3 && fromSet[fromSet.find(env.book4.ISBN)].title == env.book4.title);
+    passedTests += a_assert(fromSet.textBytes() > env.book3.title.size() + env.book4.title.size());
+    return std::make_pair(passedTests, 13);
+}
+
+std::pair<int, int> bookCatalogSortTests() {
+    int passedTests = 0;
+    TestEnvironment env;
+    Book* books[] = {&env.book1, &env.book2, &env.book3, &env.book4, &env.book5, &env.book6};
+    const char* years[] = {"2001", "1987", "2001", "1999", "", "2010"};
+    UnorderedSet<Book> bookCollection;
+    BookCatalog catalog;
+    for (int i = 0; i < 6; ++i) {
+        books[i]->yearPublished = years[i];
+        bookCollection.insert(*books[i]);
+        catalog.add(*books[i]);
+    }
+
+    // The sort paths take views straight out of the catalog
+    std::vector<BookView> shelf(catalog.begin(), catalog.end());
+    StringRadixSort<BookView, std::string_view> byTitle(shelf, [](const BookView& book) { return book.title; });
+    byTitle.sort();
+    bool sorted = true;
+    for (size_t i = 1; i < shelf.size(); ++i) {
+        sorted = sorted && shelf[i - 1].title <= shelf[i].title;
+    }
+    passedTests += a_assert(sorted && shelf.front().title == env.book2.title);
+    RadixSort<BookView, int> byYear(shelf, [](const BookView& book) { return book.yearPublished; });
+    byYear.lsdSort();
+    passedTests += a_assert(shelf.front().ISBN == env.book5.ISBN && shelf.back().ISBN == env.book6.ISBN);
+    passedTests += a_assert(shelf[3].ISBN == env.book1.ISBN && shelf[4].ISBN == env.book3.ISBN);
+
+    // A restructuring over the catalog clusters and shelves books like one over the book set
+    BorrowRecordTable table;
+    table.append(env.record1);
+    table.append(env.record2);
+    table.append(env.record3);
+    table.append(env.record4);
+    table.append(env.record5);
+    table.append(env.record6);
+    table.append(env.user1.ID, env.book3.ISBN, 100, 120);
+    table.append(env.user1.ID, env.book6.ISBN, 100, 130);
+    LibraryRestructuring fromCatalog(table, std::move(catalog));
+    LibraryRestructuring fromSet(table, bookCollection);
+    passedTests += a_assert(fromCatalog.clusterAndSort("title") == fromSet.clusterAndSort("title"));
+    passedTests += a_assert(fromCatalog.clusterAndSort("author") == fromSet.clusterAndSort("author"));
+    std::vector<std::vector<std::string>> clusters = fromCatalog.clusterAndSort("yearPublished");
+    passedTests += a_assert(clusters == fromSet.clusterAndSort("yearPublished"));
+    bool byYearInCluster = true;
+    for (const std::vector<std::string>& cluster : clusters) {
+        for (size_t i = 1; i < cluster.size(); ++i) {
+            Book previous;
+            Book current;
+            for (Book* book : books) {
+                previous = book->ISBN == cluster[i - 1] ? *book : previous;
+                current = book->ISBN == cluster[i] ? *book : current;
+            }
+            byYearInCluster = byYearInCluster && BookCatalog::parseYear(previous.yearPublished) <=
+                                                 BookCatalog::parseYear(current.yearPublished);
+        }
+    }
+    passedTests += a_assert(byYearInCluster && !clusters.empty());
+    return std::make_pair(passedTests, 7);
+}
+
+int bookCatalogTests() {
+    int passedTests = 0;
+    int totalTests = 0;
+    std::pair<int, int> r1 = stringArenaTests();
+    passedTests += r1.first;
+    totalTests += r1.second;
+    std::pair<int, int> r2 = bookCatalogTests1();
+    passedTests += r2.first;
+    totalTests += r2.second;
+    std::pair<int, int> r3 = bookCatalogSortTests();
+    passedTests += r3.first;
+    totalTests += r3.second;
+    double grade = static_cast<double>(passedTests * 100) / totalTests;
+    grade = std::round(grade * 10) / 10;
+    std::cout << "Total tests passed: " << passedTests << " out of " << totalTests << " (" << grade << "%)"  << std::endl;
+    return 0;
+}
+
+#endif //BOOKCATALOGTESTS_H
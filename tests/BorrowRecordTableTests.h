@@ -0,0 +1,97 @@
+#ifndef BORROWRECORDTABLETESTS_H
+#define BORROWRECORDTABLETESTS_H
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "../include/BorrowRecordTable.h"
+#include "../include/LibraryRestructuring.h"
+#include "TestEnvironment.h"
+
+std::pair<int, int> borrowRecordTableColumnTests() {
+    int passedTests = 0;
+    TestEnvironment env;
+    BorrowRecordTable table;
+    table.append(env.record9);
+    table.append(env.record1);
+    table.append(env.record7);
+    table.append(env.record3);
+    passedTests += a_assert(table.size() == 4);
+    passedTests += a_assert(table.patrons().size() == 2 && table.books().size() == 3);
+    passedTests += a_assert(table.record(1) == env.record1);
+    passedTests += a_assert(table.bookIds()[0] == table.books().lookup(env.book2.ISBN));
+
+    // 13 + 379 + 9 + 15 days
+    passedTests += a_assert(table.totalBorrowingTime() == 416);
+    std::vector<long long> byBook = table.borrowingTimeByBook();
+    passedTests += a_assert(byBook[table.books().lookup(env.book1.ISBN)] == 388);
+    std::vector<uint32_t> byPatron = table.recordCountByPatron();
+    passedTests += a_assert(byPatron[table.patrons().lookup(env.user1.ID)] == 2);
+    passedTests += a_assert(byPatron[table.patrons().lookup(env.user2.ID)] == 2);
+    passedTests += a_assert(table.activeOn(Date(2022, 1, 10).getDayNumber()) == 1);
+    passedTests += a_assert(table.activeOn(Date(2023, 9, 12).getDayNumber()) == 2);
+    passedTests += a_assert(table.activeOn(Date(2021, 1, 1).getDayNumber()) == 0);
+
+    table.sortBy(BorrowRecordTable::Column::CHECKOUT);
+    passedTests += a_assert(table.record(0) == env.record7 && table.record(1) == env.record9);
+    passedTests += a_assert(table.record(2) == env.record1 && table.record(3) == env.record3);
+    // Stable: user2's rows keep their checkout order
+    table.sortBy(BorrowRecordTable::Column::PATRON);
+    passedTests += a_assert(table.record(0) == env.record9 && table.record(1) == env.record3);
+    passedTests += a_assert(table.record(2) == env.record7 && table.record(3) == env.record1);
+    return std::make_pair(passedTests, 15);
+}
+
+std::pair<int, int> borrowRecordTableRestructuringTests() {
+    int passedTests = 0;
+    TestEnvironment env;
+    UnorderedSet<BorrowRecord> records;
+    records.insert(env.record1);
+    records.insert(env.record2);
+    records.insert(env.record3);
+    records.insert(env.record4);
+    records.insert(env.record5);
+    records.insert(env.record6);
+    UnorderedSet<Book> bookCollection;
+    bookCollection.insert(env.book1);
+    bookCollection.insert(env.book2);
+    bookCollection.insert(env.book3);
+    bookCollection.insert(env.book4);
+    bookCollection.insert(env.book5);
+    bookCollection.insert(env.book6);
+    BorrowRecordTable table(records);
+    LibraryRestructuring fromTable(table, bookCollection);
+    LibraryRestructuring fromRecords(records, bookCollection);
+    passedTests += a_assert(fromTable.clusterAndSort("title") == fromRecords.clusterAndSort("title"));
+    passedTests += a_assert(fromTable.clusterAndSort("author") == fromRecords.clusterAndSort("author"));
+
+    // book2 is linked through user1 and user2, both links are kept
+    BorrowRecordTable shared;
+    shared.append(env.record7);
+    shared.append(env.record8);
+    shared.append(env.record9);
+    shared.append(env.record3);
+    LibraryRestructuring libraryRestructuring(shared, bookCollection);
+    HashTable<std::string, UnorderedSet<std::string>>& graph = libraryRestructuring.getGraph();
+    passedTests += a_assert(graph[env.book2.ISBN].size() == 2);
+    passedTests += a_assert(graph[env.book1.ISBN].size() == 1 && graph[env.book3.ISBN].size() == 1);
+    std::vector<std::vector<std::string>> clusters = libraryRestructuring.clusterAndSort("title");
+    passedTests += a_assert(clusters.size() == 1 && clusters[0].size() == 3);
+    return std::make_pair(passedTests, 5);
+}
+
+int borrowRecordTableTests() {
+    int passedTests = 0;
+    int totalTests = 0;
+    std::pair<int, int> r1 = borrowRecordTableColumnTests();
+    passedTests += r1.first;
+    totalTests += r1.second;
+    std::pair<int, int> r2 = borrowRecordTableRestructuringTests();
+    passedTests += r2.first;
+    totalTests += r2.second;
+    double grade = static_cast<double>(passedTests * 100) / totalTests;
+    grade = std::round(grade * 10) / 10;
+    std::cout << "Total tests passed: " << passedTests << " out of " << totalTests << " (" << grade << "%)"  << std::endl;
+    return 0;
+}
+
+#endif //BORROWRECORDTABLETESTS_H
@@ -0,0 +1,113 @@
+#ifndef CIRCULATIONTESTS_H
+#define CIRCULATIONTESTS_H
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "../include/CirculationEngine.h"
+#include "TestEnvironment.h"
+
+std::pair<int, int> circulationBatchTests() {
+    int passedTests = 0;
+    TestEnvironment env;
+    UnorderedSet<Book> catalog;
+    env.book1.copies = 1;
+    env.book2.copies = 2;
+    catalog.insert(env.book1);
+    catalog.insert(env.book2);
+    CirculationEngine engine(catalog);
+    // Move record7 inside record1's borrow so that both want the single copy of book1
+    env.record7.checkoutDate = Date(2023, 1, 1);
+    env.record7.returnDate = Date(2023, 1, 10);
+
+    BorrowRecord backwards = env.record2;
+    backwards.checkoutDate = Date(2023, 5, 2);
+    backwards.returnDate = Date(2023, 5, 1);
+    BorrowRecord unknown = env.record3;
+    std::vector<BorrowRecord> batch = {env.record1, env.record7, env.record8, env.record9, backwards, unknown};
+    std::vector<CirculationStatus> statuses;
+    size_t accepted = engine.checkoutBatch(batch, statuses);
+    passedTests += a_assert(statuses.size() == batch.size());
+    passedTests += a_assert(statuses[0] == CirculationStatus::OK);
+    passedTests += a_assert(statuses[1] == CirculationStatus::UNAVAILABLE);
+    passedTests += a_assert(statuses[2] == CirculationStatus::OK);
+    passedTests += a_assert(statuses[3] == CirculationStatus::OK);
+    passedTests += a_assert(statuses[4] == CirculationStatus::INVALID_DATES);
+    passedTests += a_assert(statuses[5] == CirculationStatus::UNKNOWN_BOOK);
+    passedTests += a_assert(accepted == 3);
+    passedTests += a_assert(engine.copiesOnDate(env.book1.ISBN, env.record1.checkoutDate) == 0);
+    passedTests += a_assert(engine.copiesOnDate(env.record3.bookISBN, env.record1.checkoutDate) == -1);
+
+    // record7 was rejected, so its return must not release the copy record1 still holds on the same days, and
+    // neither may a return of record1's dates by another patron
+    passedTests += a_assert(engine.returnBook(env.record7) == CirculationStatus::NOT_CHECKED_OUT);
+    BorrowRecord otherPatron = env.record1;
+    otherPatron.patronId = env.user2.ID;
+    passedTests += a_assert(engine.returnBook(otherPatron) == CirculationStatus::NOT_CHECKED_OUT);
+    passedTests += a_assert(engine.copiesOnDate(env.book1.ISBN, env.record7.checkoutDate) == 0);
+
+    // Returning record1 frees book1 for record7, returning it twice is rejected
+    std::vector<BorrowRecord> returns = {env.record1, env.record1};
+    accepted = engine.returnBatch(returns, statuses);
+    passedTests += a_assert(accepted == 1 && statuses[1] == CirculationStatus::NOT_CHECKED_OUT);
+    passedTests += a_assert(engine.checkout(env.record7) == CirculationStatus::OK);
+    return std::make_pair(passedTests, 15);
+}
+
+std::pair<int, int> circulationBoundaryTests() {
+    int passedTests = 0;
+    TestEnvironment env;
+    UnorderedSet<Book> catalog;
+    env.book1.copies = 1;
+    catalog.insert(env.book1);
+    CirculationEngine engine(catalog);
+    // Move record7 inside record1's borrow so that both want the single copy of book1
+    env.record7.checkoutDate = Date(2023, 1, 1);
+    env.record7.returnDate = Date(2023, 1, 10);
+    passedTests += a_assert(engine.findBook(env.book1.ISBN) != nullptr);
+    passedTests += a_assert(engine.findBook(env.book2.ISBN) == nullptr);
+
+    engine.checkoutOrThrow(env.record1);
+    bool unavailable = false;
+    try {
+        engine.checkoutOrThrow(env.record7);
+    } catch (UnavailableBookToBorrow&) {
+        unavailable = true;
+    }
+    passedTests += a_assert(unavailable);
+
+    BorrowRecord backwards = env.record1;
+    backwards.returnDate = backwards.checkoutDate - 1;
+    bool invalidDates = false;
+    try {
+        engine.checkoutOrThrow(backwards);
+    } catch (InvalidBorrowRecordDates&) {
+        invalidDates = true;
+    }
+    passedTests += a_assert(invalidDates);
+
+    bool unknown = false;
+    try {
+        engine.returnOrThrow(env.record2);
+    } catch (std::invalid_argument&) {
+        unknown = true;
+    }
+    passedTests += a_assert(unknown);
+    return std::make_pair(passedTests, 5);
+}
+
+int circulationTests() {
+    int passedTests = 0;
+    int totalTests = 0;
+    std::pair<int, int> r1 = circulationBatchTests();
+    passedTests += r1.first;
+    totalTests += r1.second;
+    std::pair<int, int> r2 = circulationBoundaryTests();
+    passedTests += r2.first;
+    totalTests += r2.second;
+    double grade = static_cast<double>(passedTests * 100) / totalTests;
+    grade = std::round(grade * 10) / 10;
+    std::cout << "Total tests passed: " << passedTests << " out of " << totalTests << " (" << grade << "%)"  << std::endl;
+    return 0;
+}
+
+#endif //CIRCULATIONTESTS_H
@@ -0,0 +1,260 @@
+#ifndef CLUSTERINGTESTS_H
+#define CLUSTERINGTESTS_H
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../include/DisjointSet.h"
+#include "../include/LibraryRestructuring.h"
+#include "TestEnvironment.h"
+
+static std::string temporaryClusterSnapshotPath() {
+    char path[] = "/tmp/library_clusters_XXXXXX";
+    int descriptor = mkstemp(path);
+    close(descriptor);
+    return path;
+}
+
+// Random history over a catalog whose titles, authors and years repeat, so that the shelf sorts see ties. Patrons
+// borrow mostly from a small range of books, giving many clusters of different sizes.
+static void randomHistory(unsigned int seed, int recordCount, BorrowRecordTable& table, BookCatalog& catalog) {
+    const int bookCount = recordCount / 2 + 4;
+    for (int book = 0; book < bookCount; ++book) {
+        seed = seed * 1103515245 + 12345;
+        catalog.add("isbn" + std::to_string(book), "title" + std::to_string((seed >> 16) % 7),
+                    "author" + std::to_string((seed >> 20) % 5), "publisher", std::to_string(1990 + (seed >> 8) % 4), 1);
+    }
+    for (int i = 0; i < recordCount; ++i) {
+        seed = seed * 1103515245 + 12345;
+        int patron = static_cast<int>((seed >> 16) % (recordCount / 3 + 1));
+        seed = seed * 1103515245 + 12345;
+        int book = (patron * 5 + static_cast<int>((seed >> 16) % 6)) % bookCount;
+        seed = seed * 1103515245 + 12345;
+        table.append("patron" + std::to_string(patron), "isbn" + std::to_string(book), i, i + 1 + (seed >> 16) % 30);
+    }
+}
+
+std::pair<int, int> disjointSetTests() {
+    int passedTests = 0;
+    DisjointSet sets(6);
+    passedTests += a_assert(sets.size() == 6 && sets.componentCount() == 6);
+    passedTests += a_assert(sets.unite(0, 1) && sets.unite(2, 3) && sets.unite(1, 3));
+    passedTests += a_assert(!sets.unite(0, 2) && sets.componentCount() == 3);
+    passedTests += a_assert(sets.find(0) == sets.find(3) && sets.find(4) != sets.find(0) && sets.sizeOf(2) == 4);
+    uint32_t added = sets.add();
+    passedTests += a_assert(added == 6 && sets.sizeOf(added) == 1 && sets.componentCount() == 4);
+    sets.resize(10);
+    passedTests += a_assert(sets.size() == 10 && sets.componentCount() == 7);
+
+    // A long chain is flattened by the finds
+    DisjointSet chain(1000);
+    for (uint32_t element = 1; element < 1000; ++element) {
+        chain.unite(element - 1, element);
+    }
+    uint32_t root = chain.find(999);
+    bool flat = chain.sizeOf(0) == 1000 && chain.componentCount() == 1;
+    for (uint32_t element = 0; element < 1000; ++element) {
+        flat = flat && chain.find(element) == root;
+    }
+    passedTests += a_assert(flat);
+    return std::make_pair(passedTests, 7);
+}
+
+std::pair<int, int> unionFindClusteringTests() {
+    int passedTests = 0;
+    const char* keys[] = {"title", "author", "yearPublished", "none"};
+    bool same = true;
+    bool nonTrivial = false;
+    for (unsigned int round = 0; round < 6; ++round) {
+        BorrowRecordTable table;
+        BookCatalog catalog;
+        randomHistory(round * 7919 + 1, 60 + 120 * static_cast<int>(round), table, catalog);
+        BookCatalog unionCatalog;
+        for (const BookView& book : catalog) {
+            unionCatalog.add(book.ISBN, book.title, book.author, book.publisher, book.yearText, book.copies);
+        }
+        LibraryRestructuring graph(table, std::move(catalog));
+        LibraryRestructuring unionFind(table, std::move(unionCatalog),
+                                       LibraryRestructuring::ClusteringMode::UNION_FIND);
+        for (const char* key : keys) {
+            std::vector<std::vector<std::string>> expected = graph.clusterAndSort(key);
+            same = same && unionFind.clusterAndSort(key) == expected;
+            nonTrivial = nonTrivial || expected.size() > 3;
+        }
+    }
+    passedTests += a_assert(same && nonTrivial);
+
+    TestEnvironment env;
+    UnorderedSet<BorrowRecord> records;
+    records.insert(env.record1);
+    records.insert(env.record2);
+    records.insert(env.record3);
+    records.insert(env.record4);
+    records.insert(env.record5);
+    records.insert(env.record6);
+    UnorderedSet<Book> bookCollection;
+    bookCollection.insert(env.book1);
+    bookCollection.insert(env.book2);
+    bookCollection.insert(env.book3);
+    bookCollection.insert(env.book4);
+    bookCollection.insert(env.book5);
+    bookCollection.insert(env.book6);
+    BorrowRecordTable table(records);
+    LibraryRestructuring fromRecords(records, bookCollection);
+    LibraryRestructuring unionFind(table, bookCollection, LibraryRestructuring::ClusteringMode::UNION_FIND);
+    passedTests += a_assert(unionFind.clusterAndSort("title") == fromRecords.clusterAndSort("title"));
+    passedTests += a_assert(unionFind.clusterAndSort("title").size() == 2);
+    passedTests += a_assert(unionFind.getGraph().size() == 0);
+    bool thrown = false;
+    std::string path = temporaryClusterSnapshotPath();
+    try {
+        unionFind.saveSnapshot(path);
+    } catch (const std::logic_error&) {
+        thrown = true;
+    }
+    std::remove(path.c_str());
+    passedTests += a_assert(thrown);
+    return std::make_pair(passedTests, 5);
+}
+
+std::pair<int, int> bipartiteClusteringTests() {
+    int passedTests = 0;
+    const char* keys[] = {"title", "author", "yearPublished", "none"};
+    bool same = true;
+    for (unsigned int round = 0; round < 6; ++round) {
+        BorrowRecordTable table;
+        BookCatalog catalog;
+        randomHistory(round * 104729 + 3, 80 + 100 * static_cast<int>(round), table, catalog);
+        BookCatalog bipartiteCatalog;
+        for (const BookView& book : catalog) {
+            bipartiteCatalog.add(book.ISBN, book.title, book.author, book.publisher, book.yearText, book.copies);
+        }
+        LibraryRestructuring graph(table, std::move(catalog));
+        LibraryRestructuring bipartite(table, std::move(bipartiteCatalog),
+                                       LibraryRestructuring::ClusteringMode::BIPARTITE);
+        for (const char* key : keys) {
+            same = same && bipartite.clusterAndSort(key) == graph.clusterAndSort(key);
+        }
+    }
+    passedTests += a_assert(same);
+
+    // A power user links every book they borrowed; the graph mode needs a clique for it, the bipartite mode does not
+    BorrowRecordTable table;
+    for (int book = 0; book < 1500; ++book) {
+        table.append("school", "isbn" + std::to_string(book), book, book + 10);
+        table.append("reader" + std::to_string(book % 300), "isbn" + std::to_string(1500 + book), book, book + 3);
+    }
+    table.append("reader7", "isbn42", 5, 6);
+    UnorderedSet<Book> noBooks;
+    LibraryRestructuring bipartite(table, noBooks, LibraryRestructuring::ClusteringMode::BIPARTITE);
+    LibraryRestructuring graph(table, noBooks);
+    std::vector<std::vector<std::string>> clusters = bipartite.clusterAndSort("title");
+    passedTests += a_assert(clusters == graph.clusterAndSort("title"));
+    // reader7 joins the school's cluster through isbn42, the other 299 readers keep 5 books each
+    size_t largest = 0;
+    for (const std::vector<std::string>& cluster : clusters) {
+        largest = std::max(largest, cluster.size());
+    }
+    passedTests += a_assert(clusters.size() == 300 && largest == 1505);
+
+    // The co-borrow edges are still available on demand
+    TestEnvironment env;
+    BorrowRecordTable shared;
+    shared.append(env.record7);
+    shared.append(env.record8);
+    shared.append(env.record9);
+    shared.append(env.record3);
+    LibraryRestructuring small(shared, noBooks, LibraryRestructuring::ClusteringMode::BIPARTITE);
+    HashTable<std::string, UnorderedSet<std::string>>& smallGraph = small.getGraph();
+    passedTests += a_assert(smallGraph.size() == 3 && smallGraph[env.book2.ISBN].size() == 2);
+    passedTests += a_assert(smallGraph[env.book1.ISBN].size() == 1 && smallGraph[env.book1.ISBN].search(env.book2.ISBN));
+    bool thrown = false;
+    std::string path = temporaryClusterSnapshotPath();
+    try {
+        small.saveSnapshot(path);
+    } catch (const std::logic_error&) {
+        thrown = true;
+    }
+    std::remove(path.c_str());
+    passedTests += a_assert(thrown);
+    return std::make_pair(passedTests, 6);
+}
+
+// The parallel engine finds the clusters of the depth first search, from a built graph and from a mapped snapshot
+std::pair<int, int> parallelClusteringTests() {
+    int passedTests = 0;
+    const char* keys[] = {"title", "author", "yearPublished", "none"};
+    const unsigned int threadCounts[] = {2, 4, 8, 0};
+    bool same = true;
+    bool mappedSame = true;
+    for (unsigned int round = 0; round < 4; ++round) {
+        BorrowRecordTable table;
+        BookCatalog catalog;
+        // The largest history spans several chunks of vertices per thread
+        randomHistory(round * 6151 + 5, round < 3 ? 100 + 200 * static_cast<int>(round) : 40000, table, catalog);
+        LibraryRestructuring restructuring(table, std::move(catalog));
+        std::vector<std::vector<std::vector<std::string>>> expected;
+        for (const char* key : keys) {
+            expected.push_back(restructuring.clusterAndSort(key));
+        }
+        for (unsigned int threads : threadCounts) {
+            restructuring.setClusterThreads(threads);
+            for (size_t key = 0; key < 4; ++key) {
+                same = same && restructuring.clusterAndSort(keys[key]) == expected[key];
+            }
+        }
+        std::string path = temporaryClusterSnapshotPath();
+        restructuring.saveSnapshot(path);
+        LibraryRestructuring mapped = LibraryRestructuring::fromSnapshot(path);
+        mapped.setClusterThreads(4);
+        for (size_t key = 0; key < 4; ++key) {
+            mappedSame = mappedSame && mapped.clusterAndSort(keys[key]) == expected[key];
+        }
+        std::remove(path.c_str());
+    }
+    passedTests += a_assert(same);
+    passedTests += a_assert(mappedSame);
+
+    // One component holding nearly every book, next to many small ones
+    BorrowRecordTable table;
+    for (int book = 0; book < 20000; ++book) {
+        table.append("reader" + std::to_string(book / 3), "isbn" + std::to_string(book), book, book + 4);
+        table.append("reader" + std::to_string(book / 3 + 1), "isbn" + std::to_string(book), book, book + 2);
+        table.append("visitor" + std::to_string(book), "isbn" + std::to_string(20000 + book), book, book + 1);
+        table.append("visitor" + std::to_string(book), "isbn" + std::to_string(40000 + book), book, book + 1);
+    }
+    UnorderedSet<Book> noBooks;
+    LibraryRestructuring sequential(table, noBooks);
+    LibraryRestructuring parallel(table, noBooks);
+    parallel.setClusterThreads(8);
+    std::vector<std::vector<std::string>> clusters = parallel.clusterAndSort("none");
+    passedTests += a_assert(clusters == sequential.clusterAndSort("none") && clusters.size() == 20001);
+    return std::make_pair(passedTests, 3);
+}
+
+int clusteringTests() {
+    int passedTests = 0;
+    int totalTests = 0;
+    std::pair<int, int> r1 = disjointSetTests();
+    passedTests += r1.first;
+    totalTests += r1.second;
+    std::pair<int, int> r2 = unionFindClusteringTests();
+    passedTests += r2.first;
+    totalTests += r2.second;
+    std::pair<int, int> r3 = bipartiteClusteringTests();
+    passedTests += r3.first;
+    totalTests += r3.second;
+    std::pair<int, int> r4 = parallelClusteringTests();
+    passedTests += r4.first;
+    totalTests += r4.second;
+    double grade = static_cast<double>(passedTests * 100) / totalTests;
+    grade = std::round(grade * 10) / 10;
+    std::cout << "Total tests passed: " << passedTests << " out of " << totalTests << " (" << grade << "%)"  << std::endl;
+    return 0;
+}
+
+#endif //CLUSTERINGTESTS_H
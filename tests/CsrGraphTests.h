@@ -0,0 +1,158 @@
+#ifndef CSRGRAPHTESTS_H
+#define CSRGRAPHTESTS_H
+#include <iostream>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "../include/CsrGraph.h"
+#include "../include/LibraryRestructuring.h"
+#include "TestEnvironment.h"
+
+std::pair<int, int> csrGraphStructureTests() {
+    int passedTests = 0;
+    // 0 -> {1, 2}, 1 -> {}, 2 -> {0}
+    CsrGraph graph({0, 2, 2, 3}, {1, 2, 0}, {5, 6, 7});
+    passedTests += a_assert(graph.vertexCount() == 3 && graph.edgeCount() == 3 && graph.weighted());
+    passedTests += a_assert(graph.degree(0) == 2 && graph.degree(1) == 0 && *graph.begin(2) == 0);
+    CsrGraph reversed = graph.transpose(3);
+    passedTests += a_assert(reversed.degree(0) == 1 && *reversed.begin(0) == 2 && reversed.weight(0) == 7);
+    passedTests += a_assert(reversed.degree(2) == 1 && *reversed.begin(2) == 0 && reversed.weight(2) == 6);
+    passedTests += a_assert(CsrGraph().vertexCount() == 0 && CsrGraph().weight(0) == 1);
+
+    int thrown = 0;
+    try {
+        CsrGraph({0, 2, 1}, {1, 2});
+    } catch (const std::invalid_argument&) {
+        ++thrown;
+    }
+    try {
+        CsrGraph({0, 1}, {1, 2});
+    } catch (const std::invalid_argument&) {
+        ++thrown;
+    }
+    try {
+        CsrGraph({0, 2}, {1, 2}, {1});
+    } catch (const std::invalid_argument&) {
+        ++thrown;
+    }
+    passedTests += a_assert(thrown == 3);
+    return std::make_pair(passedTests, 6);
+}
+
+std::pair<int, int> csrGraphCoBorrowTests() {
+    int passedTests = 0;
+    BorrowRecordTable table;
+    // user1 borrows a twice and b; user2 borrows a, c; user3 borrows b, a, c
+    table.append("user1", "a", 1, 2);
+    table.append("user1", "b", 1, 2);
+    table.append("user2", "a", 1, 2);
+    table.append("user1", "a", 3, 4);
+    table.append("user2", "c", 1, 2);
+    table.append("user3", "b", 1, 2);
+    table.append("user3", "a", 1, 2);
+    table.append("user3", "c", 1, 2);
+    table.append("user4", "d", 1, 2);
+    uint32_t a = table.books().lookup("a");
+    uint32_t b = table.books().lookup("b");
+    uint32_t c = table.books().lookup("c");
+    uint32_t d = table.books().lookup("d");
+
+    CsrGraph patronBooks = CsrGraph::patronBooks(table);
+    uint32_t user1 = table.patrons().lookup("user1");
+    passedTests += a_assert(patronBooks.vertexCount() == 4 && patronBooks.degree(user1) == 2);
+    passedTests += a_assert(patronBooks.edgeCount() == 8);
+
+    CsrGraph graph = CsrGraph::coBorrowGraph(table, true);
+    passedTests += a_assert(graph.vertexCount() == 4 && graph.edgeCount() == 6 && graph.degree(d) == 0);
+    // a and b share user1 and user3, a and c share user2 and user3, b and c share user3
+    auto weightOf = [&](uint32_t from, uint32_t to) {
+        for (uint64_t edge = graph.offsets()[from]; edge < graph.offsets()[from + 1]; ++edge) {
+            if (graph.targets()[edge] == to) {
+                return graph.weight(edge);
+            }
+        }
+        return 0u;
+    };
+    passedTests += a_assert(weightOf(a, b) == 2 && weightOf(b, a) == 2 && weightOf(a, c) == 2);
+    passedTests += a_assert(weightOf(b, c) == 1 && weightOf(c, b) == 1 && weightOf(a, d) == 0);
+    CsrGraph unweighted = CsrGraph::coBorrowGraph(table);
+    passedTests += a_assert(!unweighted.weighted() && unweighted.targets() == graph.targets());
+    passedTests += a_assert(unweighted.memoryBytes() < graph.memoryBytes());
+    return std::make_pair(passedTests, 7);
+}
+
+// Random histories checked against a brute force adjacency matrix, and the string graph built on demand from the CSR
+std::pair<int, int> csrGraphRandomTests() {
+    int passedTests = 0;
+    unsigned int seed = 42;
+    bool same = true;
+    for (int round = 0; round < 5; ++round) {
+        BorrowRecordTable table;
+        const int patrons = 20 + round * 10;
+        const int books = 40 + round * 15;
+        for (int i = 0; i < 150 * (round + 1); ++i) {
+            seed = seed * 1103515245 + 12345;
+            int patron = static_cast<int>(seed >> 16) % patrons;
+            seed = seed * 1103515245 + 12345;
+            int book = static_cast<int>(seed >> 16) % books;
+            table.append("p" + std::to_string(patron), "b" + std::to_string(book), i, i + 1);
+        }
+        uint32_t n = static_cast<uint32_t>(table.books().size());
+        std::vector<std::vector<uint32_t>> expected(n, std::vector<uint32_t>(n, 0));
+        std::vector<std::vector<bool>> borrowed(table.patrons().size(), std::vector<bool>(n, false));
+        for (size_t row = 0; row < table.size(); ++row) {
+            borrowed[table.patronIds()[row]][table.bookIds()[row]] = true;
+        }
+        for (const std::vector<bool>& patron : borrowed) {
+            for (uint32_t x = 0; x < n; ++x) {
+                for (uint32_t y = 0; y < n; ++y) {
+                    expected[x][y] += x != y && patron[x] && patron[y];
+                }
+            }
+        }
+        CsrGraph graph = CsrGraph::coBorrowGraph(table, true);
+        for (uint32_t x = 0; x < n; ++x) {
+            std::vector<uint32_t> found(n, 0);
+            for (uint64_t edge = graph.offsets()[x]; edge < graph.offsets()[x + 1]; ++edge) {
+                // Every neighbour appears once
+                same = same && found[graph.targets()[edge]] == 0;
+                found[graph.targets()[edge]] = graph.weight(edge);
+            }
+            same = same && found == expected[x];
+        }
+    }
+    passedTests += a_assert(same);
+
+    TestEnvironment env;
+    BorrowRecordTable table;
+    table.append(env.record7);
+    table.append(env.record8);
+    table.append(env.record9);
+    table.append(env.record3);
+    UnorderedSet<Book> noBooks;
+    LibraryRestructuring restructuring(table, noBooks);
+    HashTable<std::string, UnorderedSet<std::string>>& graph = restructuring.getGraph();
+    passedTests += a_assert(graph.size() == 3 && graph[env.book2.ISBN].size() == 2);
+    passedTests += a_assert(&restructuring.getGraph() == &graph && graph[env.book1.ISBN].search(env.book2.ISBN));
+    return std::make_pair(passedTests, 3);
+}
+
+int csrGraphTests() {
+    int passedTests = 0;
+    int totalTests = 0;
+    std::pair<int, int> r1 = csrGraphStructureTests();
+    passedTests += r1.first;
+    totalTests += r1.second;
+    std::pair<int, int> r2 = csrGraphCoBorrowTests();
+    passedTests += r2.first;
+    totalTests += r2.second;
+    std::pair<int, int> r3 = csrGraphRandomTests();
+    passedTests += r3.first;
+    totalTests += r3.second;
+    double grade = static_cast<double>(passedTests * 100) / totalTests;
+    grade = std::round(grade * 10) / 10;
+    std::cout << "Total tests passed: " << passedTests << " out of " << totalTests << " (" << grade << "%)"  << std::endl;
+    return 0;
+}
+
+#endif //CSRGRAPHTESTS_H
@@ -0,0 +1,165 @@
+#ifndef CSVLOADERTESTS_H
+#define CSVLOADERTESTS_H
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../include/CsvLoader.h"
+#include "TestEnvironment.h"
+
+// Writes contents to a new temporary file and returns its path
+static std::string writeTemporaryCsv(const std::string& contents) {
+    char path[] = "/tmp/library_csv_XXXXXX";
+    int descriptor = mkstemp(path);
+    FILE* file = fdopen(descriptor, "w");
+    fwrite(contents.data(), 1, contents.size(), file);
+    fclose(file);
+    return path;
+}
+
+std::pair<int, int> csvReaderTests() {
+    int passedTests = 0;
+    std::string text = "a,\"b,1\",c\r\n\n\"multi\nline\",\"say \"\"hi\"\"\",\r\nlast,,";
+    CsvReader reader(text);
+    std::vector<CsvField> fields;
+    std::string scratch;
+    passedTests += a_assert(reader.next(fields) && fields.size() == 3);
+    passedTests += a_assert(fields[0].text == "a" && fields[1].text == "b,1" && fields[2].text == "c");
+    passedTests += a_assert(reader.next(fields) && fields.size() == 3);
+    passedTests += a_assert(fields[0].text == "multi\nline" && !fields[0].escaped);
+    passedTests += a_assert(fields[1].escaped && fields[1].value(scratch) == "say \"hi\"");
+    passedTests += a_assert(fields[2].text.empty());
+    passedTests += a_assert(reader.next(fields) && fields.size() == 3 && fields[0].text == "last");
+    passedTests += a_assert(!reader.next(fields));
+
+    // Cuts never land inside the quoted line break, and the chunks hold every record exactly once
+    std::string records;
+    for (int i = 0; i < 200; ++i) {
+        records += std::to_string(i) + ",\"note\n" + std::to_string(i) + "\",x\n";
+    }
+    std::vector<std::pair<size_t, size_t>> ranges = CsvReader::splitRecords(records, 7);
+    bool contiguous = !ranges.empty() && ranges.front().first == 0 && ranges.back().second == records.size();
+    int count = 0;
+    bool wellFormed = true;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        contiguous = contiguous && (i == 0 || ranges[i].first == ranges[i - 1].second);
+        CsvReader chunk(std::string_view(records).substr(ranges[i].first, ranges[i].second - ranges[i].first));
+        while (chunk.next(fields)) {
+            wellFormed = wellFormed && fields.size() == 3 && fields[0].text == std::to_string(count);
+            ++count;
+        }
+    }
+    passedTests += a_assert(ranges.size() == 7 && contiguous);
+    passedTests += a_assert(wellFormed && count == 200);
+
+    // Stray quotes inside unquoted fields are plain text to next(), so they must not shift the cuts into a quoted
+    // line break: every split reads the same records as one reader over the whole text
+    std::string stray;
+    for (int i = 0; i < 300; ++i) {
+        stray += std::to_string(i) + (i % 3 == 0 ? ",12\" ruler," : ",plain,") + "\"line\n" + std::to_string(i) +
+                 "\"\"\"\r\n";
+    }
+    std::vector<std::string> expected;
+    CsvReader whole(stray);
+    while (whole.next(fields)) {
+        for (const CsvField& field : fields) {
+            expected.emplace_back(field.value(scratch));
+        }
+    }
+    bool sameForEveryCount = expected.size() == 900;
+    for (size_t splits = 1; splits <= 16; ++splits) {
+        std::vector<std::string> read;
+        for (const std::pair<size_t, size_t>& range : CsvReader::splitRecords(stray, splits)) {
+            CsvReader chunk(std::string_view(stray).substr(range.first, range.second - range.first));
+            while (chunk.next(fields)) {
+                for (const CsvField& field : fields) {
+                    read.emplace_back(field.value(scratch));
+                }
+            }
+        }
+        sameForEveryCount = sameForEveryCount && read == expected;
+    }
+    passedTests += a_assert(sameForEveryCount);
+    return std::make_pair(passedTests, 11);
+}
+
+std::pair<int, int> csvLoaderObjectTests() {
+    int passedTests = 0;
+    TestEnvironment env;
+    std::string booksPath = writeTemporaryCsv(
+            "ISBN,title,author,publisher,yearPublished,copies\n"
+            "0486411044,\"Dover Thrift, Vol. 1\",\"A \"\"Quoted\"\" Author\",Dover,1999,3\n"
+            "034542705X,Timeline,Michael Crichton,Ballantine,2000,1\n");
+    std::vector<Book> books = CsvLoader(booksPath).books();
+    passedTests += a_assert(books.size() == 2);
+    passedTests += a_assert(books[0].title == "Dover Thrift, Vol. 1" && books[0].author == "A \"Quoted\" Author");
+    passedTests += a_assert(books[0].copies == 3 && books[1].ISBN == "034542705X" && books[1].yearPublished == "2000");
+    BookCatalog catalog = CsvLoader(booksPath, 2).bookCatalog();
+    passedTests += a_assert(catalog.size() == 2 && catalog[0].title == books[0].title && catalog[0].author == books[0].author);
+    passedTests += a_assert(catalog[catalog.find("034542705X")].yearPublished == 2000 && catalog[0].copies == 3);
+
+    std::string patronsPath = writeTemporaryCsv(
+            "ID,name,email,location,age\r\n"
+            "user4,Brandon Gillespie,brandon.gillespie@morris.com,\"Vancouver, BC\",-\r\n"
+            "user5,Charles Williams,charles@example.com,Burnaby,41\r\n");
+    std::vector<Patron> patrons = CsvLoader(patronsPath).patrons();
+    passedTests += a_assert(patrons.size() == 2 && patrons[0].location == "Vancouver, BC" && patrons[0].age == -1);
+    passedTests += a_assert(patrons[1].age == 41 && patrons[1].email == "charles@example.com");
+
+    // Enough records for every thread to get a chunk, loaded with 1 and 4 threads
+    std::string borrows = "patronId,bookISBN,checkoutDate,returnDate\n";
+    for (int i = 0; i < 1000; ++i) {
+        borrows += "user" + std::to_string(i % 37) + ",\"" + std::to_string(1000000000 + i % 101) + "\",2023-0" +
+                   std::to_string(1 + i % 9) + "-01,2023-0" + std::to_string(1 + i % 9) + "-1" + std::to_string(i % 10) +
+                   "\n";
+    }
+    std::string borrowsPath = writeTemporaryCsv(borrows);
+    std::vector<BorrowRecord> records = CsvLoader(borrowsPath).borrowRecords();
+    std::vector<BorrowRecord> parallelRecords = CsvLoader(borrowsPath, 4).borrowRecords();
+    passedTests += a_assert(records.size() == 1000 && records == parallelRecords);
+    passedTests += a_assert(records[13].patronId == "user13" && records[13].returnDate == Date(2023, 5, 13));
+    BorrowRecordTable table = CsvLoader(borrowsPath, 4).borrowRecordTable();
+    bool sameRows = table.size() == records.size();
+    for (size_t row = 0; row < table.size() && sameRows; ++row) {
+        sameRows = table.record(row) == records[row];
+    }
+    passedTests += a_assert(sameRows && table.patrons().size() == 37 && table.books().size() == 101);
+
+    std::string brokenPath = writeTemporaryCsv("patronId,bookISBN,checkoutDate,returnDate\nuser1,1,2023-13-01,2023-01-02\n");
+    bool thrown = false;
+    try {
+        CsvLoader(brokenPath, 2).borrowRecords();
+    } catch (std::runtime_error&) {
+        thrown = true;
+    }
+    passedTests += a_assert(thrown);
+    std::string emptyPath = writeTemporaryCsv("");
+    passedTests += a_assert(CsvLoader(emptyPath, 3).books().empty());
+
+    unlink(booksPath.c_str());
+    unlink(patronsPath.c_str());
+    unlink(borrowsPath.c_str());
+    unlink(brokenPath.c_str());
+    unlink(emptyPath.c_str());
+    return std::make_pair(passedTests, 12);
+}
+
+int csvLoaderTests() {
+    int passedTests = 0;
+    int totalTests = 0;
+    std::pair<int, int> r1 = csvReaderTests();
+    passedTests += r1.first;
+    totalTests += r1.second;
+    std::pair<int, int> r2 = csvLoaderObjectTests();
+    passedTests += r2.first;
+    totalTests += r2.second;
+    double grade = static_cast<double>(passedTests * 100) / totalTests;
+    grade = std::round(grade * 10) / 10;
+    std::cout << "Total tests passed: " << passedTests << " out of " << totalTests << " (" << grade << "%)"  << std::endl;
+    return 0;
+}
+
+#endif //CSVLOADERTESTS_H
@@ -0,0 +1,101 @@
+#ifndef DATETESTS_H
+#define DATETESTS_H
+#include <iostream>
+#include <cmath>
+#include "../include/Date.h"
+#include "TestEnvironment.h"
+
+std::pair<int, int> dateDayNumberTests() {
+    int passedTests = 0;
+    passedTests += a_assert(sizeof(Date) == 4);
+    passedTests += a_assert(Date(1970, 1, 1).getDayNumber() == 0);
+    passedTests += a_assert(Date(2000, 3, 1).getDayNumber() == 11017);
+    passedTests += a_assert(Date(1969, 12, 31).getDayNumber() == -1);
+    Date leapDay = Date::fromDayNumber(Date(2024, 2, 28).getDayNumber() + 1);
+    passedTests += a_assert(leapDay.getYear() == 2024 && leapDay.getMonth() == 2 && leapDay.getDay() == 29);
+    bool roundTrips = true;
+    for (DayNumber days = -800000; days < 800000; days += 97) {
+        Date date = Date::fromDayNumber(days);
+        if (Date(date.getYear(), date.getMonth(), date.getDay()).getDayNumber() != days)
+            roundTrips = false;
+    }
+    passedTests += a_assert(roundTrips);
+    return std::make_pair(passedTests, 6);
+}
+
+std::pair<int, int> dateArithmeticTests() {
+    int passedTests = 0;
+    passedTests += a_assert(Date::diffDuration(Date(2023, 7, 19), Date(2023, 7, 19)) == 0);
+    passedTests += a_assert(Date::diffDuration(Date(2023, 7, 15), Date(2023, 7, 20)) == 5);
+    passedTests += a_assert(Date::diffDuration(Date(2023, 6, 15), Date(2023, 7, 7)) == 22);
+    passedTests += a_assert(Date::diffDuration(Date(2023, 7, 19), Date(2023, 7, 18)) == -1);
+    passedTests += a_assert(Date::diffDuration(Date(2020, 2, 15), Date(2021, 2, 15)) == 366);
+    passedTests += a_assert(Date::diffDuration(Date(2022, 6, 15), Date(2024, 6, 15)) == 731);
+    passedTests += a_assert(Date::diffDuration(Date(2022, 11, 20), Date(2023, 2, 5)) == 77);
+    passedTests += a_assert(Date::getNextDate(Date(2023, 1, 31)) == Date(2023, 2, 1));
+    passedTests += a_assert(Date::getNextDate(Date(2023, 12, 31)) == Date(2024, 1, 1));
+    passedTests += a_assert(Date(2023, 3, 1) - 1 == Date(2023, 2, 28));
+    passedTests += a_assert(Date(2023, 12, 25) + 10 == Date(2024, 1, 4));
+    passedTests += a_assert(Date(2023, 9, 15) - Date(2022, 9, 1) == 379);
+    return std::make_pair(passedTests, 12);
+}
+
+std::pair<int, int> dateParseTests() {
+    int passedTests = 0;
+    Date date(1971, 1, 1);
+    passedTests += a_assert(Date::tryParseDate("2023-09-15", date) == DateParseError::NONE);
+    passedTests += a_assert(date == Date(2023, 9, 15));
+    passedTests += a_assert(Date::tryParseDate("2024-2-9", date) == DateParseError::NONE && date == Date(2024, 2, 9));
+    passedTests += a_assert(Date::tryParseDate("2023-13-01", date) == DateParseError::BAD_MONTH);
+    passedTests += a_assert(Date::tryParseDate("2023-02-29", date) == DateParseError::BAD_DAY);
+    passedTests += a_assert(Date::tryParseDate("2023/09/15", date) == DateParseError::BAD_FORMAT);
+    passedTests += a_assert(Date::tryParseDate("2023-09-15x", date) == DateParseError::BAD_FORMAT);
+    passedTests += a_assert(date == Date(2024, 2, 9));
+    bool thrown = false;
+    try {
+        Date::parseDate("not a date");
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    passedTests += a_assert(thrown);
+    // Fields that do not name a real day are rejected instead of rolling over, as tryParseDate rejects them
+    const int invalidDates[][3] = {{2023, 2, 29}, {2023, 2, 30}, {2023, 13, 1}, {2023, 4, 0}, {2023, 0, 10}};
+    int rejected = 0;
+    for (const int* fields : invalidDates) {
+        try {
+            Date(fields[0], fields[1], fields[2]);
+        } catch (const std::invalid_argument&) {
+            ++rejected;
+        }
+    }
+    passedTests += a_assert(rejected == 5 && Date(2024, 2, 29).getDay() == 29);
+    passedTests += a_assert(Date(2023, 9, 15).getHash() == Date::fromDayNumber(Date(2023, 9, 14).getDayNumber() + 1).getHash());
+    const char column[] = "2022-09-01,2023-09-15,2024-02-29,2023-02-29,2023-9-15 ,1999-12-31,";
+    DayNumber days[6];
+    DateParseError errors[6];
+    passedTests += a_assert(Date::parseDateColumn(column, 6, 11, days, errors) == 2);
+    passedTests += a_assert(days[0] == Date(2022, 9, 1).getDayNumber() && days[1] == Date(2023, 9, 15).getDayNumber());
+    passedTests += a_assert(days[2] == Date(2024, 2, 29).getDayNumber() && days[5] == Date(1999, 12, 31).getDayNumber());
+    passedTests += a_assert(errors[3] == DateParseError::BAD_DAY && errors[4] == DateParseError::BAD_FORMAT);
+    return std::make_pair(passedTests, 15);
+}
+
+int dateTests() {
+    int passedTests = 0;
+    int totalTests = 0;
+    std::pair<int, int> r1 = dateDayNumberTests();
+    passedTests += r1.first;
+    totalTests += r1.second;
+    std::pair<int, int> r2 = dateArithmeticTests();
+    passedTests += r2.first;
+    totalTests += r2.second;
+    std::pair<int, int> r3 = dateParseTests();
+    passedTests += r3.first;
+    totalTests += r3.second;
+    double grade = static_cast<double>(passedTests * 100) / totalTests;
+    grade = std::round(grade * 10) / 10;
+    std::cout << "Total tests passed: " << passedTests << " out of " << totalTests << " (" << grade << "%)"  << std::endl;
+    return 0;
+}
+
+#endif //DATETESTS_H
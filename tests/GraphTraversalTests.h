@@ -0,0 +1,174 @@
+#ifndef GRAPHTRAVERSALTESTS_H
+#define GRAPHTRAVERSALTESTS_H
+#include <iostream>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "../include/DenseBitset.h"
+#include "../include/GraphTraversal.h"
+#include "../include/LibraryRestructuring.h"
+
+std::pair<int, int> denseBitsetTests() {
+    int passedTests = 0;
+    DenseBitset bits(130);
+    passedTests += a_assert(bits.size() == 130 && bits.count() == 0);
+    bits.set(0);
+    bits.set(64);
+    bits.set(129);
+    passedTests += a_assert(bits.test(0) && bits.test(64) && bits.test(129) && !bits.test(63) && bits.count() == 3);
+    passedTests += a_assert(bits.testAndSet(64) && !bits.testAndSet(65) && bits.count() == 4);
+    bits.reset(0);
+    passedTests += a_assert(!bits.test(0) && bits.count() == 3);
+    // Shrinking drops the bits past the new size, growing again does not bring them back
+    bits.resize(100);
+    bits.resize(200);
+    passedTests += a_assert(!bits.test(129) && bits.count() == 2 && bits.size() == 200);
+    bits.clear();
+    passedTests += a_assert(bits.count() == 0);
+    return std::make_pair(passedTests, 6);
+}
+
+// Reference traversals: a recursive depth first search and a textbook breadth first search
+static void recursiveDepthFirst(const CsrGraph& graph, uint32_t vertex, std::vector<bool>& visited,
+                                std::vector<uint32_t>& reached) {
+    visited[vertex] = true;
+    reached.push_back(vertex);
+    for (const uint32_t* next = graph.begin(vertex); next != graph.end(vertex); ++next) {
+        if (!visited[*next]) {
+            recursiveDepthFirst(graph, *next, visited, reached);
+        }
+    }
+}
+
+static CsrGraph randomGraph(unsigned int seed, uint32_t vertexCount, uint32_t edgeCount) {
+    std::vector<std::vector<uint32_t>> neighbours(vertexCount);
+    for (uint32_t edge = 0; edge < edgeCount; ++edge) {
+        seed = seed * 1103515245 + 12345;
+        uint32_t from = (seed >> 8) % vertexCount;
+        seed = seed * 1103515245 + 12345;
+        uint32_t to = (seed >> 8) % vertexCount;
+        neighbours[from].push_back(to);
+        neighbours[to].push_back(from);
+    }
+    std::vector<uint64_t> offsets(1, 0);
+    std::vector<uint32_t> targets;
+    for (const std::vector<uint32_t>& list : neighbours) {
+        targets.insert(targets.end(), list.begin(), list.end());
+        offsets.push_back(targets.size());
+    }
+    return CsrGraph(offsets, targets);
+}
+
+std::pair<int, int> graphTraversalOrderTests() {
+    int passedTests = 0;
+    bool sameDepthFirst = true;
+    bool sameBreadthFirst = true;
+    for (unsigned int round = 0; round < 5; ++round) {
+        CsrGraph graph = randomGraph(round + 11, 200 + round * 100, 150 + round * 120);
+        GraphTraversal depthFirst(graph);
+        GraphTraversal breadthFirst(graph);
+        std::vector<bool> visited(graph.vertexCount(), false);
+        std::vector<bool> queued(graph.vertexCount(), false);
+        for (uint32_t start = 0; start < graph.vertexCount(); ++start) {
+            std::vector<uint32_t> expected;
+            if (!visited[start]) {
+                recursiveDepthFirst(graph, start, visited, expected);
+            }
+            std::vector<uint32_t> reached;
+            depthFirst.depthFirst(start, reached);
+            sameDepthFirst = sameDepthFirst && reached == expected;
+
+            std::vector<uint32_t> level;
+            if (!queued[start]) {
+                queued[start] = true;
+                level.push_back(start);
+                for (size_t head = 0; head < level.size(); ++head) {
+                    for (const uint32_t* next = graph.begin(level[head]); next != graph.end(level[head]); ++next) {
+                        if (!queued[*next]) {
+                            queued[*next] = true;
+                            level.push_back(*next);
+                        }
+                    }
+                }
+            }
+            // Appends after what is already in reached
+            std::vector<uint32_t> breadth(1, UINT32_MAX);
+            breadthFirst.breadthFirst(start, breadth);
+            level.insert(level.begin(), UINT32_MAX);
+            sameBreadthFirst = sameBreadthFirst && breadth == level;
+        }
+    }
+    passedTests += a_assert(sameDepthFirst);
+    passedTests += a_assert(sameBreadthFirst);
+
+    CsrGraph graph = randomGraph(3, 50, 80);
+    GraphTraversal traversal(graph);
+    std::vector<uint32_t> reached;
+    traversal.depthFirst(0, reached);
+    size_t first = reached.size();
+    traversal.depthFirst(0, reached);
+    passedTests += a_assert(first > 0 && reached.size() == first && traversal.visited(0));
+    traversal.reset();
+    passedTests += a_assert(!traversal.visited(0));
+    return std::make_pair(passedTests, 4);
+}
+
+// Paths far deeper than any thread stack would allow recursion for
+std::pair<int, int> graphTraversalDepthTests() {
+    int passedTests = 0;
+    const uint32_t length = 2000000;
+    std::vector<uint64_t> offsets(length + 1, 0);
+    std::vector<uint32_t> targets;
+    targets.reserve(2 * length);
+    for (uint32_t vertex = 0; vertex < length; ++vertex) {
+        if (vertex > 0) {
+            targets.push_back(vertex - 1);
+        }
+        if (vertex + 1 < length) {
+            targets.push_back(vertex + 1);
+        }
+        offsets[vertex + 1] = targets.size();
+    }
+    CsrGraph path(offsets, targets);
+    GraphTraversal traversal(path);
+    std::vector<uint32_t> reached;
+    traversal.depthFirst(0, reached);
+    passedTests += a_assert(reached.size() == length && reached.back() == length - 1);
+    traversal.reset();
+    reached.clear();
+    traversal.breadthFirst(length / 2, reached);
+    passedTests += a_assert(reached.size() == length);
+
+    // A 300k book chain of patrons clusters as one
+    BorrowRecordTable table;
+    for (int book = 0; book < 300000; ++book) {
+        std::string patron = "patron" + std::to_string(book);
+        table.append(patron, "isbn" + std::to_string(book), book, book + 1);
+        table.append(patron, "isbn" + std::to_string(book + 1), book, book + 2);
+    }
+    UnorderedSet<Book> noBooks;
+    LibraryRestructuring restructuring(table, noBooks);
+    std::vector<std::vector<std::string>> clusters = restructuring.clusterAndSort("none");
+    passedTests += a_assert(clusters.size() == 1 && clusters[0].size() == 300001);
+    return std::make_pair(passedTests, 3);
+}
+
+int graphTraversalTests() {
+    int passedTests = 0;
+    int totalTests = 0;
+    std::pair<int, int> r1 = denseBitsetTests();
+    passedTests += r1.first;
+    totalTests += r1.second;
+    std::pair<int, int> r2 = graphTraversalOrderTests();
+    passedTests += r2.first;
+    totalTests += r2.second;
+    std::pair<int, int> r3 = graphTraversalDepthTests();
+    passedTests += r3.first;
+    totalTests += r3.second;
+    double grade = static_cast<double>(passedTests * 100) / totalTests;
+    grade = std::round(grade * 10) / 10;
+    std::cout << "Total tests passed: " << passedTests << " out of " << totalTests << " (" << grade << "%)"  << std::endl;
+    return 0;
+}
+
+#endif //GRAPHTRAVERSALTESTS_H
@@ -0,0 +1,48 @@
+#ifndef KEYENCODINGTESTS_H
+#define KEYENCODINGTESTS_H
+#include <iostream>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "../include/StringInterner.h"
+#include "TestEnvironment.h"
+
+std::pair<int, int> stringInternerTests() {
+    int passedTests = 0;
+    TestEnvironment env;
+    StringInterner interner(2);
+    passedTests += a_assert(interner.intern(env.book1.ISBN) == 0);
+    passedTests += a_assert(interner.intern(env.book2.ISBN) == 1);
+    passedTests += a_assert(interner.intern(env.book1.ISBN) == 0);
+    passedTests += a_assert(interner.lookup(env.book3.ISBN) == StringInterner::NOT_FOUND);
+    passedTests += a_assert(interner.intern("") == 2 && interner.resolve(2).empty());
+
+    // Enough strings to grow the table several times, ids stay dense and stable
+    std::vector<std::string> keys;
+    for (int i = 0; i < 5000; ++i) {
+        keys.push_back("patron" + std::to_string(i * 7));
+        interner.intern(keys.back());
+    }
+    bool stable = interner.size() == 5003;
+    for (int i = 0; i < 5000 && stable; ++i) {
+        uint32_t id = interner.lookup(keys[i]);
+        stable = id == static_cast<uint32_t>(i + 3) && interner.resolve(id) == keys[i];
+    }
+    passedTests += a_assert(stable);
+    passedTests += a_assert(interner.lookup(env.book2.ISBN) == 1 && interner.resolve(1) == env.book2.ISBN);
+    return std::make_pair(passedTests, 7);
+}
+
+int keyEncodingTests() {
+    int passedTests = 0;
+    int totalTests = 0;
+    std::pair<int, int> r1 = stringInternerTests();
+    passedTests += r1.first;
+    totalTests += r1.second;
+    double grade = static_cast<double>(passedTests * 100) / totalTests;
+    grade = std::round(grade * 10) / 10;
+    std::cout << "Total tests passed: " << passedTests << " out of " << totalTests << " (" << grade << "%)"  << std::endl;
+    return 0;
+}
+
+#endif //KEYENCODINGTESTS_H
@@ -67,6 +67,68 @@ std::pair<int, int> libraryRestructuringTests2(){
     return std::make_pair(passedTests, 7);
 }
 
+// A book borrowed by several patrons keeps the edges from all of them, and the graph matches a brute force union of
+// every patron's books
+std::pair<int, int> libraryRestructuringTests3(){
+    int passedTests = 0;
+    TestEnvironment env;
+    UnorderedSet<BorrowRecord> records;
+    records.insert(env.record7);
+    records.insert(env.record8);
+    records.insert(env.record9);
+    records.insert(env.record3);
+    UnorderedSet<Book> bookCollection;
+    bookCollection.insert(env.book1);
+    bookCollection.insert(env.book2);
+    bookCollection.insert(env.book3);
+    LibraryRestructuring libraryRestructuring(records, bookCollection);
+    HashTable<std::string, UnorderedSet<std::string>>& graph = libraryRestructuring.getGraph();
+    passedTests += a_assert(graph[env.book2.ISBN].size() == 2);
+    passedTests += a_assert(graph[env.book2.ISBN].search(env.book1.ISBN) && graph[env.book2.ISBN].search(env.book3.ISBN));
+
+    UnorderedSet<BorrowRecord> randomRecords;
+    std::vector<std::pair<int, int>> borrows;
+    unsigned int seed = 8042;
+    for (int i = 0; i < 400; ++i) {
+        seed = seed * 1103515245 + 12345;
+        int patron = static_cast<int>(seed >> 16) % 60;
+        seed = seed * 1103515245 + 12345;
+        int book = static_cast<int>(seed >> 16) % 150;
+        BorrowRecord record;
+        record.patronId = "patron" + std::to_string(patron);
+        record.bookISBN = "isbn" + std::to_string(book);
+        record.checkoutDate = Date(2023, 1, 1) + i;
+        record.returnDate = record.checkoutDate + 1 + i % 20;
+        randomRecords.insert(record);
+        borrows.emplace_back(patron, book);
+    }
+    UnorderedSet<Book> noBooks;
+    LibraryRestructuring randomRestructuring(randomRecords, noBooks);
+    HashTable<std::string, UnorderedSet<std::string>>& randomGraph = randomRestructuring.getGraph();
+    std::vector<std::vector<bool>> expected(150, std::vector<bool>(150, false));
+    for (const std::pair<int, int>& a : borrows) {
+        for (const std::pair<int, int>& b : borrows) {
+            if (a.first == b.first && a.second != b.second) {
+                expected[a.second][b.second] = true;
+            }
+        }
+    }
+    bool same = true;
+    for (const std::pair<int, int>& borrow : borrows) {
+        UnorderedSet<std::string>* edges = randomGraph.search("isbn" + std::to_string(borrow.second));
+        size_t degree = 0;
+        for (int other = 0; other < 150 && edges; ++other) {
+            if (expected[borrow.second][other]) {
+                ++degree;
+                same = same && edges->search("isbn" + std::to_string(other));
+            }
+        }
+        same = same && edges && edges->size() == degree;
+    }
+    passedTests += a_assert(same);
+    return std::make_pair(passedTests, 3);
+}
+
 /*
 std::pair<int, int> dateDifferenceTests() {
     int passedTests = 0;
@@ -112,6 +174,9 @@ int libraryRestructuringTests() {
     std::pair<int, int> r2 = libraryRestructuringTests2();
     passedTests += r2.first;
     totalTests += r2.second;
+    std::pair<int, int> r4 = libraryRestructuringTests3();
+    passedTests += r4.first;
+    totalTests += r4.second;
     //std::pair<int, int> r3 = dateDifferenceTests();
     //passedTests += r3.first;
     //totalTests += r3.second;
@@ -0,0 +1,185 @@
+#ifndef LIBRARYSNAPSHOTTESTS_H
+#define LIBRARYSNAPSHOTTESTS_H
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../include/LibrarySnapshot.h"
+#include "../include/LibraryRestructuring.h"
+#include "TestEnvironment.h"
+
+static std::string temporarySnapshotPath() {
+    char path[] = "/tmp/library_snapshot_XXXXXX";
+    int descriptor = mkstemp(path);
+    close(descriptor);
+    return path;
+}
+
+static std::string readSnapshotBytes(const std::string& path) {
+    MappedFile file(path);
+    return std::string(file.text());
+}
+
+static void writeSnapshotBytes(const std::string& path, const std::string& bytes) {
+    FILE* file = fopen(path.c_str(), "wb");
+    fwrite(bytes.data(), 1, bytes.size(), file);
+    fclose(file);
+}
+
+static bool snapshotOpens(const std::string& path, bool verify) {
+    try {
+        LibrarySnapshot snapshot(path, verify);
+        return true;
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+}
+
+std::pair<int, int> librarySnapshotRoundTripTests() {
+    int passedTests = 0;
+    TestEnvironment env;
+    UnorderedSet<BorrowRecord> records;
+    records.insert(env.record1);
+    records.insert(env.record2);
+    records.insert(env.record3);
+    records.insert(env.record4);
+    records.insert(env.record5);
+    records.insert(env.record6);
+    UnorderedSet<Book> bookCollection;
+    bookCollection.insert(env.book1);
+    bookCollection.insert(env.book2);
+    bookCollection.insert(env.book3);
+    bookCollection.insert(env.book4);
+    bookCollection.insert(env.book5);
+    bookCollection.insert(env.book6);
+    LibraryRestructuring built(records, bookCollection);
+    std::string path = temporarySnapshotPath();
+    built.saveSnapshot(path);
+
+    LibrarySnapshot snapshot(path);
+    passedTests += a_assert(snapshot.bookCount() == 6);
+    passedTests += a_assert(snapshot.nodeCount() >= snapshot.rootCount() && snapshot.rootCount() > 0);
+    uint32_t node = 0;
+    while (node < snapshot.nodeCount() && snapshot.string(snapshot.nodeIsbn(node)) != env.book1.ISBN) {
+        ++node;
+    }
+    passedTests += a_assert(node < snapshot.nodeCount() && snapshot.nodeBook(node) != LibrarySnapshot::NO_BOOK);
+    passedTests += a_assert(snapshot.string(snapshot.book(snapshot.nodeBook(node)).title) == env.book1.title);
+
+    LibraryRestructuring mapped = LibraryRestructuring::fromSnapshot(path);
+    passedTests += a_assert(mapped.clusterAndSort("title") == built.clusterAndSort("title"));
+    passedTests += a_assert(mapped.clusterAndSort("author") == built.clusterAndSort("author"));
+    passedTests += a_assert(mapped.clusterAndSort("yearPublished") == built.clusterAndSort("yearPublished"));
+    passedTests += a_assert(mapped.clusterAndSort("none") == built.clusterAndSort("none"));
+
+    // A snapshot saved from a mapped one holds the same contents
+    std::string copyPath = temporarySnapshotPath();
+    mapped.saveSnapshot(copyPath);
+    passedTests += a_assert(readSnapshotBytes(copyPath) == readSnapshotBytes(path));
+    std::remove(copyPath.c_str());
+    std::remove(path.c_str());
+
+    // An empty restructuring still round trips
+    UnorderedSet<BorrowRecord> noRecords;
+    UnorderedSet<Book> noBooks;
+    LibraryRestructuring empty(noRecords, noBooks);
+    std::string emptyPath = temporarySnapshotPath();
+    empty.saveSnapshot(emptyPath);
+    passedTests += a_assert(LibraryRestructuring::fromSnapshot(emptyPath).clusterAndSort("title").empty());
+    std::remove(emptyPath.c_str());
+
+    // Years that are not plain numbers are saved as they were given
+    BookCatalog catalog;
+    catalog.add(env.book1.ISBN, env.book1.title, env.book1.author, env.book1.publisher, "c. 1850", 1);
+    catalog.add(env.book2.ISBN, env.book2.title, env.book2.author, env.book2.publisher, "0999", 1);
+    catalog.add(env.book3.ISBN, env.book3.title, env.book3.author, env.book3.publisher, "", 1);
+    BorrowRecordTable table;
+    table.append(env.record1);
+    table.append(env.record2);
+    LibraryRestructuring oddYears(table, std::move(catalog));
+    std::string yearsPath = temporarySnapshotPath();
+    oddYears.saveSnapshot(yearsPath);
+    std::vector<std::string> years;
+    {
+        LibrarySnapshot yearsSnapshot(yearsPath);
+        for (size_t index = 0; index < yearsSnapshot.bookCount(); ++index) {
+            years.emplace_back(yearsSnapshot.string(yearsSnapshot.book(index).yearPublished));
+        }
+    }
+    std::remove(yearsPath.c_str());
+    passedTests += a_assert(years == std::vector<std::string>({"c. 1850", "0999", ""}));
+    return std::make_pair(passedTests, 11);
+}
+
+std::pair<int, int> librarySnapshotValidationTests() {
+    int passedTests = 0;
+    TestEnvironment env;
+    UnorderedSet<BorrowRecord> records;
+    records.insert(env.record1);
+    records.insert(env.record2);
+    records.insert(env.record3);
+    UnorderedSet<Book> bookCollection;
+    bookCollection.insert(env.book1);
+    bookCollection.insert(env.book2);
+    bookCollection.insert(env.book3);
+    LibraryRestructuring built(records, bookCollection);
+    std::string path = temporarySnapshotPath();
+    built.saveSnapshot(path);
+    std::string bytes = readSnapshotBytes(path);
+    std::string brokenPath = temporarySnapshotPath();
+
+    passedTests += a_assert(snapshotOpens(path, true));
+    // A flipped byte in the payload fails the checksum, and is only accepted when verification is skipped
+    std::string flipped = bytes;
+    flipped[sizeof(SnapshotHeader) + 3] ^= 0x40;
+    writeSnapshotBytes(brokenPath, flipped);
+    passedTests += a_assert(!snapshotOpens(brokenPath, true));
+    passedTests += a_assert(snapshotOpens(brokenPath, false));
+
+    std::string badMagic = bytes;
+    badMagic[0] = 'X';
+    writeSnapshotBytes(brokenPath, badMagic);
+    passedTests += a_assert(!snapshotOpens(brokenPath, false));
+
+    std::string badVersion = bytes;
+    badVersion[8] = static_cast<char>(LibrarySnapshot::VERSION + 1);
+    writeSnapshotBytes(brokenPath, badVersion);
+    passedTests += a_assert(!snapshotOpens(brokenPath, false));
+
+    writeSnapshotBytes(brokenPath, bytes.substr(0, bytes.size() - 8));
+    passedTests += a_assert(!snapshotOpens(brokenPath, false));
+    writeSnapshotBytes(brokenPath, bytes.substr(0, sizeof(SnapshotHeader) / 2));
+    passedTests += a_assert(!snapshotOpens(brokenPath, false));
+
+    // Missing files throw from fromSnapshot as well
+    bool thrown = false;
+    try {
+        LibraryRestructuring::fromSnapshot("/tmp/library_snapshot_missing");
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    passedTests += a_assert(thrown);
+    std::remove(brokenPath.c_str());
+    std::remove(path.c_str());
+    return std::make_pair(passedTests, 8);
+}
+
+int librarySnapshotTests() {
+    int passedTests = 0;
+    int totalTests = 0;
+    std::pair<int, int> r1 = librarySnapshotRoundTripTests();
+    passedTests += r1.first;
+    totalTests += r1.second;
+    std::pair<int, int> r2 = librarySnapshotValidationTests();
+    passedTests += r2.first;
+    totalTests += r2.second;
+    double grade = static_cast<double>(passedTests * 100) / totalTests;
+    grade = std::round(grade * 10) / 10;
+    std::cout << "Total tests passed: " << passedTests << " out of " << totalTests << " (" << grade << "%)"  << std::endl;
+    return 0;
+}
+
+#endif //LIBRARYSNAPSHOTTESTS_H
@@ -6,8 +6,11 @@
 #define MERGESORTTESTS_H
 #include <iostream>
 #include <cmath>
+#include <algorithm>
+#include <string>
 #include "../include/Utils.h"
 #include "../include/MergeSort.h"
+#include "../include/ExternalMergeSort.h"
 #include "TestEnvironment.h"
 
 bool intCompare(const int& a, const int& b) {
@@ -130,6 +133,138 @@ std::pair<int, int> mergeSortMoreTests() {
     return std::make_pair(passedTests, 2);
 }
 
+std::pair<int, int> mergeSortAdaptiveTests() {
+    int passedTests = 0;
+    long comparisons = 0;
+    MergeSort<int> countingSort([&](const int& a, const int& b) {
+        comparisons++;
+        return a < b;
+    });
+    std::vector<int> sortedVector;
+    for (int i = 0; i < 100000; i++)
+        sortedVector.push_back(i);
+    countingSort.adaptiveSort(sortedVector);
+    passedTests += a_assert(std::is_sorted(sortedVector.begin(), sortedVector.end()));
+    passedTests += a_assert(comparisons == 99999);
+    std::vector<int> reversedVector(sortedVector.rbegin(), sortedVector.rend());
+    comparisons = 0;
+    countingSort.adaptiveSort(reversedVector);
+    passedTests += a_assert(reversedVector == sortedVector);
+    passedTests += a_assert(comparisons == 99999);
+    std::vector<int> nearlySortedVector = sortedVector;
+    for (int i = 0; i < 100000; i += 10000)
+        std::swap(nearlySortedVector[i], nearlySortedVector[i + 5000]);
+    comparisons = 0;
+    countingSort.adaptiveSort(nearlySortedVector);
+    passedTests += a_assert(nearlySortedVector == sortedVector);
+    passedTests += a_assert(comparisons < 2 * 100000);
+    std::vector<std::pair<int, int>> pairVector;
+    for (int i = 0; i < 5000; i++)
+        pairVector.emplace_back((i * 7919) % 13, i);
+    MergeSort<std::pair<int, int>> pairSort([](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        return a.first < b.first; });
+    pairSort.adaptiveSort(pairVector);
+    bool isStable = true;
+    for (size_t i = 0; i < pairVector.size() - 1; i++) {
+        if (pairVector[i].first > pairVector[i + 1].first ||
+            (pairVector[i].first == pairVector[i + 1].first && pairVector[i].second > pairVector[i + 1].second)) {
+            isStable = false;
+            break;
+        }
+    }
+    passedTests += a_assert(isStable);
+    std::vector<std::string> strVec = {"banana", "apple", "cherry", "date", "blueberry"};
+    MergeSort<std::string> strSort(stringCompare);
+    strSort.adaptiveSort(strVec);
+    passedTests += a_assert(strVec == std::vector<std::string>({"apple", "banana", "blueberry", "cherry", "date"}));
+    return std::make_pair(passedTests, 8);
+}
+
+std::pair<int, int> mergeSortExternalTests() {
+    int passedTests = 0;
+    ExternalMergeSort<int> intSort(intCompare, 4096);
+    std::vector<int> expected;
+    for (int i = 0; i < 50000; i++) {
+        int value = (i * 7919) % 50021;
+        intSort.add(value);
+        expected.push_back(value);
+    }
+    passedTests += a_assert(intSort.runCount() > 1);
+    std::vector<int> sortedInts;
+    intSort.sort([&](const int& value) { sortedInts.push_back(value); });
+    std::sort(expected.begin(), expected.end());
+    passedTests += a_assert(sortedInts == expected);
+    TestEnvironment env;
+    ExternalMergeSort<BorrowRecord> recordSort([](const BorrowRecord& a, const BorrowRecord& b) {
+        return a.checkoutDate < b.checkoutDate; }, 1024);
+    std::vector<BorrowRecord> records = {env.record1, env.record2, env.record3, env.record4, env.record5,
+                                         env.record6, env.record7, env.record8, env.record9};
+    for (int i = 0; i < 100; i++)
+        recordSort.add(records[i % records.size()]);
+    passedTests += a_assert(recordSort.runCount() > 1);
+    std::vector<BorrowRecord> sortedRecords;
+    recordSort.sort([&](const BorrowRecord& record) { sortedRecords.push_back(record); });
+    bool isSorted = sortedRecords.size() == 100;
+    for (size_t i = 0; isSorted && i < sortedRecords.size() - 1; i++) {
+        if (sortedRecords[i + 1].checkoutDate < sortedRecords[i].checkoutDate)
+            isSorted = false;
+    }
+    passedTests += a_assert(isSorted);
+    passedTests += a_assert(sortedRecords[0] == env.record7);
+    passedTests += a_assert(sortedRecords[99].patronId == env.record3.patronId);
+    return std::make_pair(passedTests, 6);
+}
+
+// Everything the sort holds, buffered elements, run sort scratch space and I/O buffers, stays within the budget
+std::pair<int, int> mergeSortExternalBudgetTests() {
+    int passedTests = 0;
+    const size_t budget = 1 << 20;
+    const int count = 200000;
+    auto value = [](int i) {
+        return "patron-" + std::to_string((i * 7919L) % 200003) + std::string(static_cast<size_t>(i % 40), 'x');
+    };
+    bool sorted = true;
+    int outputCount = 0;
+    ExternalMergeSort<std::string> stringSort([](const std::string& a, const std::string& b) { return a < b; },
+                                              budget);
+    for (int i = 0; i < count; i++) {
+        stringSort.add(value(i));
+    }
+    size_t spilledRuns = stringSort.runCount();
+    std::string previous;
+    stringSort.sort([&](const std::string& element) {
+        sorted = sorted && previous <= element;
+        previous = element;
+        ++outputCount;
+    });
+    passedTests += a_assert(sorted && outputCount == count && spilledRuns > 1);
+    // The buffered elements fill most of the budget before every spill, and the merge heads may go a little over
+    passedTests += a_assert(stringSort.peakMemory() > budget / 2 && stringSort.peakMemory() <= budget + budget / 16);
+    return std::make_pair(passedTests, 2);
+}
+
+std::pair<int, int> mergeSortByKeyTests() {
+    int passedTests = 0;
+    TestEnvironment env;
+    std::vector<Book> books = {env.book1, env.book2, env.book3, env.book4, env.book5};
+    int extractions = 0;
+    MergeSort<std::string> titleSort(stringCompare);
+    titleSort.sortByKey(books, [&](const Book& book) {
+        extractions++;
+        return book.title; });
+    passedTests += a_assert(extractions == 5);
+    passedTests += a_assert(books[0].ISBN == env.book2.ISBN);
+    passedTests += a_assert(books[1].ISBN == env.book1.ISBN);
+    passedTests += a_assert(books[2].ISBN == env.book3.ISBN);
+    passedTests += a_assert(books[3].ISBN == env.book5.ISBN);
+    passedTests += a_assert(books[4].ISBN == env.book4.ISBN);
+    std::vector<std::string> words = {"kiwi", "fig", "apple", "date", "plum", "banana"};
+    MergeSort<int> lengthSort(intCompare);
+    lengthSort.sortByKey(words, [](const std::string& word) { return static_cast<int>(word.length()); });
+    passedTests += a_assert(words == std::vector<std::string>({"fig", "kiwi", "date", "plum", "apple", "banana"}));
+    return std::make_pair(passedTests, 7);
+}
+
 int mergeSortTests() {
     int passedTests = 0;
     int totalTests = 0;
@@ -142,6 +277,18 @@ int mergeSortTests() {
     std::pair<int, int> r3 = mergeSortMoreTests();
     passedTests += r3.first;
     totalTests += r3.second;
+    std::pair<int, int> r4 = mergeSortAdaptiveTests();
+    passedTests += r4.first;
+    totalTests += r4.second;
+    std::pair<int, int> r5 = mergeSortExternalTests();
+    passedTests += r5.first;
+    totalTests += r5.second;
+    std::pair<int, int> r6 = mergeSortByKeyTests();
+    passedTests += r6.first;
+    totalTests += r6.second;
+    std::pair<int, int> r7 = mergeSortExternalBudgetTests();
+    passedTests += r7.first;
+    totalTests += r7.second;
     double grade = static_cast<double>(passedTests * 100) / totalTests;
     grade = std::round(grade * 10) / 10;
     std::cout << "Total tests passed: " << passedTests << " out of " << totalTests << " (" << grade << "%)"  << std::endl;
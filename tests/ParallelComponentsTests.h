@@ -0,0 +1,115 @@
+#ifndef PARALLELCOMPONENTSTESTS_H
+#define PARALLELCOMPONENTSTESTS_H
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "../include/CsrGraph.h"
+#include "../include/GraphTraversal.h"
+#include "../include/ParallelComponents.h"
+
+// Undirected graph of groupCount groups of consecutive vertices, each joined by random edges inside the group, plus
+// bridges random edges between any two vertices. Self loops and repeated edges are kept on purpose.
+static CsrGraph groupedGraph(unsigned int seed, uint32_t vertexCount, uint32_t groupCount, uint32_t edgeCount,
+                             uint32_t bridges) {
+    std::vector<std::vector<uint32_t>> neighbours(vertexCount);
+    uint32_t groupSize = (vertexCount + groupCount - 1) / groupCount;
+    for (uint32_t edge = 0; edge < edgeCount + bridges; ++edge) {
+        seed = seed * 1103515245 + 12345;
+        uint32_t from = (seed >> 8) % vertexCount;
+        seed = seed * 1103515245 + 12345;
+        uint32_t to = (seed >> 8) % vertexCount;
+        if (edge < edgeCount) {
+            uint32_t group = from / groupSize * groupSize;
+            to = group + to % std::min(groupSize, vertexCount - group);
+        }
+        neighbours[from].push_back(to);
+        neighbours[to].push_back(from);
+    }
+    std::vector<uint64_t> offsets(1, 0);
+    std::vector<uint32_t> targets;
+    for (const std::vector<uint32_t>& list : neighbours) {
+        targets.insert(targets.end(), list.begin(), list.end());
+        offsets.push_back(targets.size());
+    }
+    return CsrGraph(offsets, targets);
+}
+
+// Smallest vertex of every component, found by the sequential search
+static std::vector<uint32_t> sequentialLabels(const CsrGraph& graph) {
+    std::vector<uint32_t> labels(graph.vertexCount());
+    GraphTraversal traversal(graph);
+    std::vector<uint32_t> reached;
+    for (uint32_t start = 0; start < graph.vertexCount(); ++start) {
+        reached.clear();
+        traversal.depthFirst(start, reached);
+        for (uint32_t vertex : reached) {
+            labels[vertex] = start;
+        }
+    }
+    return labels;
+}
+
+std::pair<int, int> parallelComponentsLabelTests() {
+    int passedTests = 0;
+    const unsigned int threadCounts[] = {1, 2, 3, 8};
+    bool same = true;
+    // From thousands of small components to one that holds nearly everything, over several chunks per thread
+    const uint32_t groupCounts[] = {5000, 300, 20, 1};
+    for (unsigned int round = 0; round < 4; ++round) {
+        CsrGraph graph = groupedGraph(round * 31 + 7, 40000, groupCounts[round], 30000 + round * 10000, round * 5);
+        std::vector<uint32_t> expected = sequentialLabels(graph);
+        for (unsigned int threads : threadCounts) {
+            same = same && ParallelComponents(graph, threads).labels() == expected;
+        }
+    }
+    passedTests += a_assert(same);
+
+    // A path whose ids zigzag, so that every link first hooks a large root onto a small one far away
+    const uint32_t length = 100000;
+    std::vector<uint32_t> order(length);
+    for (uint32_t step = 0; step < length; ++step) {
+        order[step] = step % 2 == 0 ? step / 2 : length - 1 - step / 2;
+    }
+    std::vector<std::vector<uint32_t>> neighbours(length);
+    for (uint32_t step = 1; step < length; ++step) {
+        neighbours[order[step - 1]].push_back(order[step]);
+        neighbours[order[step]].push_back(order[step - 1]);
+    }
+    std::vector<uint64_t> offsets(1, 0);
+    std::vector<uint32_t> targets;
+    for (const std::vector<uint32_t>& list : neighbours) {
+        targets.insert(targets.end(), list.begin(), list.end());
+        offsets.push_back(targets.size());
+    }
+    CsrGraph path(offsets, targets);
+    bool onePath = true;
+    for (unsigned int threads : threadCounts) {
+        std::vector<uint32_t> labels = ParallelComponents(path, threads).labels();
+        for (uint32_t vertex = 0; vertex < length; ++vertex) {
+            onePath = onePath && labels[vertex] == 0;
+        }
+    }
+    passedTests += a_assert(onePath);
+
+    // Isolated vertices label themselves and an empty graph has no labels
+    CsrGraph isolated(std::vector<uint64_t>(6, 0), std::vector<uint32_t>());
+    passedTests += a_assert(ParallelComponents(isolated, 4).labels() == std::vector<uint32_t>({0, 1, 2, 3, 4}));
+    CsrGraph empty;
+    passedTests += a_assert(ParallelComponents(empty, 4).labels().empty());
+    passedTests += a_assert(ParallelComponents(empty, 0).threadCount() >= 1);
+    return std::make_pair(passedTests, 5);
+}
+
+int parallelComponentsTests() {
+    int passedTests = 0;
+    int totalTests = 0;
+    std::pair<int, int> r1 = parallelComponentsLabelTests();
+    passedTests += r1.first;
+    totalTests += r1.second;
+    double grade = static_cast<double>(passedTests * 100) / totalTests;
+    grade = std::round(grade * 10) / 10;
+    std::cout << "Total tests passed: " << passedTests << " out of " << totalTests << " (" << grade << "%)"  << std::endl;
+    return 0;
+}
+
+#endif //PARALLELCOMPONENTSTESTS_H
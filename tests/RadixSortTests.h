@@ -6,8 +6,11 @@
 #define RADIXSORTTESTS_H
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 #include "../include/Utils.h"
 #include "../include/RadixSort.h"
+#include "../include/StringRadixSort.h"
+#include "../include/TopK.h"
 #include "TestEnvironment.h"
 
 int intKey(const int& num) {
@@ -118,6 +121,204 @@ std::pair<int, int> radixSortVectorObject(){
     return std::make_pair(passedTests, 9);
 }
 
+std::pair<int, int> radixSortLsdTests() {
+    int passedTests = 0;
+    std::vector<int> expected;
+    for (int i = 0; i < 100000; i++)
+        expected.push_back(static_cast<int>((i * 48271LL) % 2147483) - 1000000);
+    std::vector<int> unsortedVector = expected;
+    std::sort(expected.begin(), expected.end());
+    for (int digitBits : {8, 11, 16}) {
+        std::vector<int> intVector = unsortedVector;
+        RadixSort<int> intSort(intVector, intKey);
+        intSort.lsdSort(digitBits);
+        passedTests += a_assert(intVector == expected);
+    }
+    std::vector<int> smallVector = {170, 45, 75, 90, 802, 24, 2, 66};
+    RadixSort<int> smallSort(smallVector, intKey);
+    smallSort.lsdSort();
+    passedTests += a_assert(smallVector == std::vector<int>({2, 24, 45, 66, 75, 90, 170, 802}));
+    std::vector<std::vector<std::string>> data = {{"grape"}, {"date", "fig"}, {"kiwi", "melon"}, {"apple"}};
+    RadixSort<std::vector<std::string>> vectorSort(data, [](const std::vector<std::string>& vct) {
+        return static_cast<int>(vct.size()); });
+    vectorSort.lsdSort();
+    passedTests += a_assert(data == std::vector<std::vector<std::string>>(
+            {{"grape"}, {"apple"}, {"date", "fig"}, {"kiwi", "melon"}}));
+    bool thrown = false;
+    try {
+        smallSort.lsdSort(4);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    passedTests += a_assert(thrown);
+    return std::make_pair(passedTests, 6);
+}
+
+std::pair<int, int> radixSortKeyTypeTests() {
+    int passedTests = 0;
+    std::vector<int> negativeVector = {5, -3, 0, -2147483647 - 1, 2147483647, -1, 42};
+    RadixSort<int> negativeSort(negativeVector, intKey);
+    negativeSort.lsdSort();
+    passedTests += a_assert(negativeVector == std::vector<int>({-2147483647 - 1, -3, -1, 0, 5, 42, 2147483647}));
+    std::vector<int64_t> longVector = {5000000000LL, -5000000000LL, 0, -1, 1LL << 40};
+    RadixSort<int64_t, int64_t> longSort(longVector, [](const int64_t& num) { return num; });
+    longSort.lsdSort(11);
+    passedTests += a_assert(longVector == std::vector<int64_t>({-5000000000LL, -1, 0, 5000000000LL, 1LL << 40}));
+    std::vector<uint64_t> unsignedVector = {18446744073709551615ULL, 0, 1ULL << 63, 7};
+    RadixSort<uint64_t, uint64_t> unsignedSort(unsignedVector, [](const uint64_t& num) { return num; });
+    unsignedSort.lsdSort(16);
+    passedTests += a_assert(unsignedVector == std::vector<uint64_t>({0, 7, 1ULL << 63, 18446744073709551615ULL}));
+    std::vector<float> floatVector = {3.5f, -0.25f, 0.0f, -100.0f, 1e-6f, 2.0f};
+    RadixSort<float, float> floatSort(floatVector, [](const float& num) { return num; });
+    floatSort.lsdSort();
+    passedTests += a_assert(floatVector == std::vector<float>({-100.0f, -0.25f, 0.0f, 1e-6f, 2.0f, 3.5f}));
+    std::vector<double> doubleVector = {12.9, 12.2, -3.14, 1.618, 0.577, 12.5};
+    RadixSort<double, double> doubleSort(doubleVector, [](const double& num) { return num; });
+    doubleSort.lsdSort();
+    passedTests += a_assert(doubleVector == std::vector<double>({-3.14, 0.577, 1.618, 12.2, 12.5, 12.9}));
+    doubleSort.lsdSort(8, SortOrder::DESCENDING);
+    passedTests += a_assert(doubleVector == std::vector<double>({12.9, 12.5, 12.2, 1.618, 0.577, -3.14}));
+    std::vector<std::string> strVec = {"fig", "apple", "kiwi", "date", "banana", "plum"};
+    RadixSort<std::string> lengthSort(strVec, stringKey);
+    lengthSort.lsdSort(8, SortOrder::DESCENDING);
+    passedTests += a_assert(strVec == std::vector<std::string>({"banana", "apple", "kiwi", "date", "plum", "fig"}));
+    return std::make_pair(passedTests, 7);
+}
+
+std::pair<int, int> radixSortIndexTests() {
+    int passedTests = 0;
+    int keyEvaluations = 0;
+    std::vector<std::vector<std::string>> data = {{"apple", "banana", "cherry", "sourcherry"}, {"date", "fig", "melon"},
+                                                  {"kiwi", "watermelon"}, {"grape"}, {"lime", "plum"}};
+    RadixSort<std::vector<std::string>, double> clusterSort(data, [&](const std::vector<std::string>& vct) {
+        keyEvaluations++;
+        double sum = 0;
+        for (const std::string& str : vct)
+            sum += str.length();
+        return sum / vct.size(); });
+    clusterSort.indexSort();
+    passedTests += a_assert(keyEvaluations == 5);
+    passedTests += a_assert(data[0][0] == "date");
+    passedTests += a_assert(data[1][0] == "lime");
+    passedTests += a_assert(data[2][0] == "grape");
+    passedTests += a_assert(data[3][0] == "apple");
+    passedTests += a_assert(data[4][0] == "kiwi");
+    clusterSort.indexSort(11, SortOrder::DESCENDING);
+    passedTests += a_assert(data[0][0] == "kiwi" && data[3][0] == "date" && data[4][0] == "lime");
+    std::vector<int> intVector;
+    for (int i = 0; i < 100000; i++)
+        intVector.push_back(static_cast<int>((i * 48271LL) % 2147483) - 1000000);
+    std::vector<int> expected = intVector;
+    std::sort(expected.begin(), expected.end());
+    RadixSort<int> intSort(intVector, intKey);
+    intSort.indexSort(16);
+    passedTests += a_assert(intVector == expected);
+    return std::make_pair(passedTests, 8);
+}
+
+std::pair<int, int> stringRadixSortTests() {
+    int passedTests = 0;
+    TestEnvironment env;
+    std::vector<Book> books = {env.book1, env.book2, env.book3, env.book4, env.book5,
+                               env.book6, env.book7, env.book8, env.book9, env.book10};
+    StringRadixSort<Book, std::string_view> titleSort(books, [](const Book& book) {
+        return std::string_view(book.title); });
+    titleSort.sort();
+    passedTests += a_assert(books[0].ISBN == env.book9.ISBN);
+    passedTests += a_assert(books[1].ISBN == env.book2.ISBN);
+    passedTests += a_assert(books[2].ISBN == env.book8.ISBN);
+    passedTests += a_assert(books[9].ISBN == env.book4.ISBN);
+    std::vector<std::string> ISBNs = {env.book1.ISBN, env.book2.ISBN, env.book3.ISBN, env.book4.ISBN};
+    StringRadixSort<std::string> authorSort(ISBNs, [&](const std::string& ISBN) {
+        for (const Book& book : {env.book1, env.book2, env.book3, env.book4})
+            if (book.ISBN == ISBN)
+                return book.author;
+        return std::string(); });
+    authorSort.sort();
+    passedTests += a_assert(ISBNs == std::vector<std::string>({env.book1.ISBN, env.book4.ISBN, env.book3.ISBN,
+                                                               env.book2.ISBN}));
+    std::vector<std::string> largeStringVector;
+    for (int i = 20000; i > 0; i--)
+        largeStringVector.push_back("String_" + std::to_string(i % 7000));
+    std::vector<std::string> expected = largeStringVector;
+    std::sort(expected.begin(), expected.end());
+    StringRadixSort<std::string, std::string_view> largeSort(largeStringVector, [](const std::string& str) {
+        return std::string_view(str); });
+    largeSort.sort();
+    passedTests += a_assert(largeStringVector == expected);
+    return std::make_pair(passedTests, 6);
+}
+
+std::pair<int, int> radixSortParallelTests() {
+    int passedTests = 0;
+    std::vector<int> intVector;
+    for (int i = 0; i < 200000; i++)
+        intVector.push_back(static_cast<int>((i * 48271LL) % 2147483) - 1000000);
+    std::vector<int> expected = intVector;
+    std::sort(expected.begin(), expected.end());
+    for (unsigned int threads : {1u, 3u, 4u}) {
+        std::vector<int> data = intVector;
+        RadixSort<int> intSort(data, intKey);
+        intSort.parallelSort(threads);
+        passedTests += a_assert(data == expected);
+    }
+    std::vector<std::pair<int, int>> pairVector;
+    for (int i = 0; i < 100000; i++)
+        pairVector.emplace_back(i % 97, i);
+    RadixSort<std::pair<int, int>> pairSort(pairVector, [](const std::pair<int, int>& p) { return p.first; });
+    pairSort.parallelSort(4, 11, SortOrder::DESCENDING);
+    bool isStable = true;
+    for (size_t i = 0; i < pairVector.size() - 1; i++) {
+        if (pairVector[i].first < pairVector[i + 1].first ||
+            (pairVector[i].first == pairVector[i + 1].first && pairVector[i].second > pairVector[i + 1].second)) {
+            isStable = false;
+            break;
+        }
+    }
+    passedTests += a_assert(isStable);
+    return std::make_pair(passedTests, 4);
+}
+
+std::pair<int, int> radixSortTopKTests() {
+    int passedTests = 0;
+    std::vector<int> intVector;
+    for (int i = 0; i < 100000; i++)
+        intVector.push_back(static_cast<int>((i * 48271LL) % 2147483) - 1000000);
+    std::vector<int> expected = intVector;
+    std::sort(expected.begin(), expected.end());
+    std::vector<int> smallest = intVector;
+    RadixSort<int> smallestSort(smallest, intKey);
+    smallestSort.partialSort(100);
+    passedTests += a_assert(std::equal(expected.begin(), expected.begin() + 100, smallest.begin()));
+    std::vector<int> rest(smallest.begin() + 100, smallest.end());
+    std::sort(rest.begin(), rest.end());
+    passedTests += a_assert(std::equal(rest.begin(), rest.end(), expected.begin() + 100));
+    std::vector<double> averages = {12.2, 45.0, 2.0, 12.9, 45.0, 7.5, 30.25};
+    RadixSort<double, double> longestSort(averages, [](const double& days) { return days; });
+    longestSort.partialSort(3, SortOrder::DESCENDING);
+    passedTests += a_assert(averages[0] == 45.0 && averages[1] == 45.0 && averages[2] == 30.25);
+    std::vector<std::pair<int, int>> ties = {{1, 0}, {5, 1}, {5, 2}, {3, 3}, {5, 4}, {5, 5}};
+    RadixSort<std::pair<int, int>> tieSort(ties, [](const std::pair<int, int>& p) { return p.first; });
+    tieSort.partialSort(3, SortOrder::DESCENDING);
+    passedTests += a_assert(ties[0].second == 1 && ties[1].second == 2 && ties[2].second == 4);
+    TopK<std::vector<std::string>, double> counterClusters(2, [](const std::vector<std::string>& cluster) {
+        return static_cast<double>(cluster.size()); });
+    counterClusters.push({"grape"});
+    counterClusters.push({"date", "fig", "melon"});
+    counterClusters.push({"kiwi", "watermelon"});
+    counterClusters.push({"apple", "banana", "cherry", "sourcherry"});
+    counterClusters.push({"lime", "plum", "pear"});
+    std::vector<std::vector<std::string>> top = counterClusters.result();
+    passedTests += a_assert(counterClusters.size() == 2 && top.size() == 2);
+    passedTests += a_assert(top[0][0] == "apple" && top[1][0] == "date");
+    TopK<int> smallestStream(5, intKey, SortOrder::ASCENDING);
+    for (int value : intVector)
+        smallestStream.push(value);
+    std::vector<int> smallestFive = smallestStream.result();
+    passedTests += a_assert(std::equal(expected.begin(), expected.begin() + 5, smallestFive.begin()));
+    return std::make_pair(passedTests, 7);
+}
+
 int radixSortTests() {
     int passedTests = 0;
     int totalTests = 0;
@@ -130,6 +331,24 @@ int radixSortTests() {
     std::pair<int, int> r3 = radixSortVectorObject();
     passedTests += r3.first;
     totalTests += r3.second;
+    std::pair<int, int> r4 = radixSortLsdTests();
+    passedTests += r4.first;
+    totalTests += r4.second;
+    std::pair<int, int> r5 = radixSortKeyTypeTests();
+    passedTests += r5.first;
+    totalTests += r5.second;
+    std::pair<int, int> r6 = radixSortIndexTests();
+    passedTests += r6.first;
+    totalTests += r6.second;
+    std::pair<int, int> r7 = stringRadixSortTests();
+    passedTests += r7.first;
+    totalTests += r7.second;
+    std::pair<int, int> r8 = radixSortParallelTests();
+    passedTests += r8.first;
+    totalTests += r8.second;
+    std::pair<int, int> r9 = radixSortTopKTests();
+    passedTests += r9.first;
+    totalTests += r9.second;
     double grade = static_cast<double>(passedTests * 100) / totalTests;
     grade = std::round(grade * 10) / 10;
     std::cout << "Total tests passed: " << passedTests << " out of " << totalTests << " (" << grade << "%)"  << std::endl;
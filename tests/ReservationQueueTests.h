@@ -0,0 +1,220 @@
+#ifndef RESERVATIONQUEUETESTS_H
+#define RESERVATIONQUEUETESTS_H
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include "../include/ReservationQueue.h"
+#include "TestEnvironment.h"
+
+std::pair<int, int> reservationQueueSingleThreadTests() {
+    int passedTests = 0;
+    TestEnvironment env;
+    ReservationQueue<BorrowRecord> queue(3);
+    passedTests += a_assert(queue.capacity() == 4);
+    passedTests += a_assert(queue.tryPush(env.record1));
+    passedTests += a_assert(queue.tryPush(env.record2));
+    passedTests += a_assert(queue.tryPush(env.record3));
+    passedTests += a_assert(queue.tryPush(env.record4));
+    passedTests += a_assert(!queue.tryPush(env.record5));
+    BorrowRecord record;
+    passedTests += a_assert(queue.tryPop(record) && record == env.record1);
+    passedTests += a_assert(queue.tryPush(env.record5));
+    passedTests += a_assert(queue.tryPop(record) && record == env.record2);
+    passedTests += a_assert(queue.tryPop(record) && record == env.record3);
+    passedTests += a_assert(queue.tryPop(record) && record == env.record4);
+    passedTests += a_assert(queue.tryPop(record) && record == env.record5);
+    passedTests += a_assert(!queue.tryPop(record));
+    return std::make_pair(passedTests, 13);
+}
+
+std::pair<int, int> reservationQueueBoundaryTests() {
+    int passedTests = 0;
+    TestEnvironment env;
+    ReservationQueue<BorrowRecord> queue(2);
+    queue.pushOrThrow(env.record1);
+    queue.pushOrThrow(env.record2);
+    bool full = false;
+    try {
+        queue.pushOrThrow(env.record3);
+    } catch (LibraryReservationQueueFull&) {
+        full = true;
+    }
+    passedTests += a_assert(full);
+    passedTests += a_assert(queue.popOrThrow() == env.record1);
+
+    // Closing keeps what is queued but refuses new reservations
+    queue.close();
+    passedTests += a_assert(!queue.push(env.record3));
+    BorrowRecord record;
+    passedTests += a_assert(queue.pop(record) && record == env.record2);
+    passedTests += a_assert(!queue.pop(record));
+    bool unavailable = false;
+    try {
+        queue.popOrThrow();
+    } catch (ReservationRecordUnavailable&) {
+        unavailable = true;
+    }
+    passedTests += a_assert(unavailable);
+    bool closed = false;
+    try {
+        queue.pushOrThrow(env.record3);
+    } catch (LibraryReservationQueueClosed&) {
+        closed = true;
+    }
+    passedTests += a_assert(closed);
+    return std::make_pair(passedTests, 7);
+}
+
+std::pair<int, int> reservationQueueConcurrentTests() {
+    int passedTests = 0;
+    const int producers = 4;
+    const int consumers = 4;
+    const long perProducer = 50000;
+    // A small queue keeps producers and consumers wrapping around the ring and blocking on each other
+    ReservationQueue<long> queue(64);
+    std::atomic<long> sum(0);
+    std::atomic<long> count(0);
+    std::vector<int> seen(producers * perProducer, 0);
+    std::atomic<bool> ordered(true);
+    std::vector<std::thread> threads;
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&]() {
+            long value;
+            // Values from one producer must come out in the order it pushed them
+            std::vector<long> last(producers, -1);
+            while (queue.pop(value)) {
+                long producer = value / perProducer;
+                if (value <= last[producer]) {
+                    ordered = false;
+                }
+                last[producer] = value;
+                seen[value] += 1;
+                sum += value;
+                ++count;
+            }
+        });
+    }
+    std::vector<std::thread> pushers;
+    for (int p = 0; p < producers; ++p) {
+        pushers.emplace_back([&, p]() {
+            for (long i = 0; i < perProducer; ++i) {
+                queue.push(p * perProducer + i);
+            }
+        });
+    }
+    for (std::thread& pusher : pushers) {
+        pusher.join();
+    }
+    queue.close();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    long n = producers * perProducer;
+    bool exactlyOnce = true;
+    for (int times : seen) {
+        exactlyOnce = exactlyOnce && times == 1;
+    }
+    passedTests += a_assert(count == n);
+    passedTests += a_assert(sum == n * (n - 1) / 2);
+    passedTests += a_assert(exactlyOnce);
+    passedTests += a_assert(ordered);
+    return std::make_pair(passedTests, 4);
+}
+
+// Closing while producers are still pushing: every push that returned true must come out of a pop
+std::pair<int, int> reservationQueueCloseRaceTests() {
+    int passedTests = 0;
+    const int producers = 4;
+    const int consumers = 2;
+    bool allDelivered = true;
+    for (int round = 0; round < 50; ++round) {
+        ReservationQueue<long> queue(16);
+        std::atomic<long> accepted(0);
+        std::atomic<long> popped(0);
+        std::vector<std::thread> threads;
+        for (int c = 0; c < consumers; ++c) {
+            threads.emplace_back([&]() {
+                long value;
+                while (queue.pop(value)) {
+                    ++popped;
+                }
+            });
+        }
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p]() {
+                for (long i = 0; queue.push(p * 1000000L + i); ++i) {
+                    ++accepted;
+                }
+            });
+        }
+        // Lets the producers get going, a little later every round
+        for (int spin = 0; spin < round * 200; ++spin) {
+            std::this_thread::yield();
+        }
+        queue.close();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        allDelivered = allDelivered && accepted == popped;
+    }
+    passedTests += a_assert(allDelivered);
+    return std::make_pair(passedTests, 1);
+}
+
+// A consumer waiting on an empty queue and a producer waiting on a full one park instead of spinning: the process
+// uses far less CPU time than the wall-clock time they wait
+std::pair<int, int> reservationQueueParkingTests() {
+    int passedTests = 0;
+    ReservationQueue<int> empty(2);
+    int received = 0;
+    std::thread consumer([&]() { empty.pop(received); });
+    std::clock_t start = std::clock();
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    double consumerSeconds = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+    empty.push(42);
+    consumer.join();
+    passedTests += a_assert(received == 42 && consumerSeconds < 0.1);
+
+    ReservationQueue<int> full(2);
+    full.tryPush(1);
+    full.tryPush(2);
+    bool pushed = true;
+    std::thread producer([&]() { pushed = full.push(3); });
+    start = std::clock();
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    double producerSeconds = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+    full.close();
+    producer.join();
+    passedTests += a_assert(!pushed && producerSeconds < 0.1);
+    return std::make_pair(passedTests, 2);
+}
+
+int reservationQueueTests() {
+    int passedTests = 0;
+    int totalTests = 0;
+    std::pair<int, int> r1 = reservationQueueSingleThreadTests();
+    passedTests += r1.first;
+    totalTests += r1.second;
+    std::pair<int, int> r2 = reservationQueueBoundaryTests();
+    passedTests += r2.first;
+    totalTests += r2.second;
+    std::pair<int, int> r3 = reservationQueueConcurrentTests();
+    passedTests += r3.first;
+    totalTests += r3.second;
+    std::pair<int, int> r4 = reservationQueueCloseRaceTests();
+    passedTests += r4.first;
+    totalTests += r4.second;
+    std::pair<int, int> r5 = reservationQueueParkingTests();
+    passedTests += r5.first;
+    totalTests += r5.second;
+    double grade = static_cast<double>(passedTests * 100) / totalTests;
+    grade = std::round(grade * 10) / 10;
+    std::cout << "Total tests passed: " << passedTests << " out of " << totalTests << " (" << grade << "%)"  << std::endl;
+    return 0;
+}
+
+#endif //RESERVATIONQUEUETESTS_H